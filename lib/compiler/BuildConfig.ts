@@ -68,6 +68,37 @@ export class BuildConfig {
       },
     })
 
+    // Profile-guided release, in two passes over the same sources: run the
+    // pgo-generate binary on a representative workload, then rebuild with
+    // pgo-use from the .gcda profile it wrote (see PgoPipeline.ts, which
+    // adds -fprofile-dir and runs the training traces).
+    this.presets.set('pgo-generate', {
+      id: 'pgo-generate',
+      name: 'PGO Instrumented',
+      buildCommand: 'build',
+      flags: ['-O2', '-DNDEBUG', '-fprofile-generate', '-fprofile-update=single'],
+      env: {
+        NODE_ENV: 'production',
+      },
+    })
+
+    this.presets.set('pgo-use', {
+      id: 'pgo-use',
+      name: 'PGO + LTO Release',
+      buildCommand: 'build',
+      flags: [
+        '-O2',
+        '-DNDEBUG',
+        '-fprofile-use',
+        '-fprofile-correction',
+        '-flto=auto',
+        '-march=native',
+      ],
+      env: {
+        NODE_ENV: 'production',
+      },
+    })
+
     this.presets.set('development', {
       id: 'development',
       name: 'Development',
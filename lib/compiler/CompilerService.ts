@@ -277,7 +277,7 @@ export class CompilerService {
     options: CompileOptions
   ): Promise<CompileResult> {
     return new Promise((resolve) => {
-      const process = spawn(compiler, args, {
+      const child = spawn(compiler, args, {
         cwd: options.cwd || process.cwd(),
         env: {
           ...process.env,
@@ -289,15 +289,15 @@ export class CompilerService {
       let stdout = ''
       let stderr = ''
 
-      process.stdout.on('data', (data) => {
+      child.stdout.on('data', (data) => {
         stdout += data.toString()
       })
 
-      process.stderr.on('data', (data) => {
+      child.stderr.on('data', (data) => {
         stderr += data.toString()
       })
 
-      process.on('close', (code) => {
+      child.on('close', (code) => {
         resolve({
           success: code === 0,
           output: stdout,
@@ -306,7 +306,7 @@ export class CompilerService {
         })
       })
 
-      process.on('error', (error) => {
+      child.on('error', (error) => {
         resolve({
           success: false,
           error: error.message,
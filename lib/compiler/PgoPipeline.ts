@@ -0,0 +1,424 @@
+/**
+ * PGO Pipeline
+ *
+ * Profile-guided (PGO) + link-time optimized release builds for the
+ * menu-driven C list programs (runtime-projects/.../dsa code).
+ *
+ * Per program:
+ *   1. build the baseline: the 'release' preset plus the -flto and -march
+ *      flags of 'pgo-use', so the two builds differ only in the profile
+ *   2. build the 'pgo-generate' preset and run it on a training trace
+ *   3. rebuild with 'pgo-use' (-fprofile-use -flto -march=native) from
+ *      the profile written in step 2, failing if no profile was written
+ *   4. time baseline and PGO binaries on a separate evaluation trace
+ *
+ * A trace is the program's stdin: menu choices and items, ending with the
+ * exit choice, so the programs need no separate batch mode. Traces are
+ * either recorded files or synthesized from a seeded op mix that keeps
+ * the list long enough for the walks (insert_end, delete_end, search and
+ * the after-op display) to dominate, since those and the menu dispatch
+ * are the branches PGO lays out.
+ */
+
+import { spawn } from 'child_process'
+import { promises as fs } from 'fs'
+import { join } from 'path'
+import { getBuildConfig } from './BuildConfig'
+import { getCompilerService } from './CompilerService'
+
+export interface TraceOp {
+  choice: number
+  weight: number
+  // Extra inputs read by the op (items, k), one token each
+  args?: number
+  // Inputs are drawn from [0, argMax); 100000 by default
+  argMax?: number
+  // Change in list length: +1 insert, -1 delete, 0 otherwise
+  delta?: number
+  // Only issued while the list has at least this many nodes
+  minLength?: number
+}
+
+export interface PgoProgram {
+  name: string
+  sourceFile: string
+  // Tokens read before the first menu (e.g. the create_sll item)
+  preludeItems: number
+  exitChoice: number
+  ops: TraceOp[]
+  flags?: string[]
+  // Recorded stdin traces; synthesized when absent
+  trainTrace?: string
+  evalTrace?: string
+}
+
+export interface PgoOptions {
+  // Directory holding the C sources; builds go to <projectPath>/.pgo
+  projectPath: string
+  programs?: PgoProgram[]
+  // Ops per synthesized trace; 15000 by default, which keeps each timed
+  // run well above process startup
+  traceOps?: number
+  seed?: number
+  // Timed runs per binary, 5 by default; the median is reported
+  runs?: number
+  // Passed as -march=; 'native' by default
+  march?: string
+  timeoutMs?: number
+}
+
+export interface PgoProgramResult {
+  name: string
+  success: boolean
+  baselineMs?: number
+  pgoMs?: number
+  speedup?: number
+  trainMs?: number
+  error?: string
+}
+
+export interface PgoReport {
+  results: PgoProgramResult[]
+  summary: string
+}
+
+/**
+ * The dsa code menu programs. insert_LOC is left out: menu_DLL's walks
+ * an uninitialized pointer.
+ */
+export const DSA_LIST_PROGRAMS: PgoProgram[] = [
+  {
+    name: 'menu_linked',
+    sourceFile: 'menu_linked.c',
+    preludeItems: 1,
+    exitChoice: 10,
+    ops: [
+      { choice: 2, weight: 3, args: 1, delta: 1 },
+      { choice: 3, weight: 4, args: 1, delta: 1 },
+      { choice: 4, weight: 2, delta: -1, minLength: 1 },
+      { choice: 5, weight: 2, delta: -1, minLength: 1 },
+      { choice: 6, weight: 3, args: 1 },
+      { choice: 7, weight: 0.05 },
+      { choice: 8, weight: 0.2 },
+      { choice: 9, weight: 1 },
+    ],
+  },
+  {
+    name: 'csll',
+    sourceFile: 'csll.c',
+    preludeItems: 1,
+    exitChoice: 9,
+    ops: [
+      { choice: 1, weight: 3, args: 1, delta: 1 },
+      { choice: 2, weight: 4, args: 1, delta: 1 },
+      { choice: 3, weight: 2, delta: -1, minLength: 1 },
+      { choice: 4, weight: 2, delta: -1, minLength: 1 },
+      { choice: 6, weight: 1, args: 1, argMax: 64 },
+      { choice: 7, weight: 2 },
+      { choice: 8, weight: 1 },
+    ],
+  },
+  {
+    name: 'CDLL',
+    sourceFile: 'CDLL.c',
+    preludeItems: 1,
+    exitChoice: 9,
+    ops: [
+      { choice: 1, weight: 3, args: 1, delta: 1 },
+      { choice: 2, weight: 4, args: 1, delta: 1 },
+      { choice: 3, weight: 2, delta: -1, minLength: 1 },
+      { choice: 4, weight: 2, delta: -1, minLength: 1 },
+      { choice: 6, weight: 1, args: 1, argMax: 64 },
+      { choice: 7, weight: 2 },
+      { choice: 8, weight: 1 },
+    ],
+  },
+  {
+    name: 'menu_DLL',
+    sourceFile: 'menu_DLL.c',
+    preludeItems: 1,
+    exitChoice: 8,
+    ops: [
+      { choice: 2, weight: 3, args: 1, delta: 1 },
+      { choice: 3, weight: 4, args: 1, delta: 1 },
+      { choice: 5, weight: 2, delta: -1, minLength: 1 },
+      { choice: 6, weight: 2, delta: -1, minLength: 1 },
+      { choice: 7, weight: 1 },
+    ],
+  },
+  {
+    name: 'linked_stack_menu',
+    sourceFile: 'linked_stack_menu.c',
+    preludeItems: 0,
+    exitChoice: 5,
+    ops: [
+      { choice: 1, weight: 5, args: 1, delta: 1 },
+      { choice: 2, weight: 3, delta: -1, minLength: 1 },
+      { choice: 4, weight: 1 },
+    ],
+  },
+  {
+    name: 'linked_queue_menu',
+    sourceFile: 'linked_queue_menu.c',
+    preludeItems: 0,
+    exitChoice: 5,
+    ops: [
+      { choice: 1, weight: 5, args: 1, delta: 1 },
+      { choice: 2, weight: 3, delta: -1, minLength: 1 },
+      { choice: 4, weight: 1 },
+    ],
+  },
+]
+
+/**
+ * PGO Pipeline
+ *
+ * Builds, trains and times PGO + LTO binaries against LTO-only builds.
+ */
+export class PgoPipeline {
+  private static instance: PgoPipeline
+
+  private constructor() {}
+
+  static getInstance(): PgoPipeline {
+    if (!PgoPipeline.instance) {
+      PgoPipeline.instance = new PgoPipeline()
+    }
+    return PgoPipeline.instance
+  }
+
+  /**
+   * Run the pipeline over every program
+   */
+  async run(options: PgoOptions): Promise<PgoReport> {
+    const programs = options.programs || DSA_LIST_PROGRAMS
+    const results: PgoProgramResult[] = []
+
+    // Relative paths: the compiler runs through a shell in projectPath,
+    // and 'dsa code' would split at the space.
+    for (const dir of ['.pgo/release', '.pgo/pgo', '.pgo/traces']) {
+      await fs.mkdir(join(options.projectPath, dir), { recursive: true })
+    }
+
+    for (const program of programs) {
+      try {
+        results.push(await this.runProgram(program, options))
+      } catch (error) {
+        results.push({
+          name: program.name,
+          success: false,
+          error: error instanceof Error ? error.message : String(error),
+        })
+      }
+    }
+
+    return {
+      results,
+      summary: this.formatReport(results),
+    }
+  }
+
+  /**
+   * Baseline, instrumented and PGO builds plus timing for one program
+   */
+  private async runProgram(program: PgoProgram, options: PgoOptions): Promise<PgoProgramResult> {
+    const config = getBuildConfig()
+    const generate = config.getPreset('pgo-generate')?.flags || []
+    const use = (config.getPreset('pgo-use')?.flags || []).map((flag) =>
+      flag.startsWith('-march=') ? `-march=${options.march || 'native'}` : flag
+    )
+    // Same LTO and ISA as the PGO build, so the speedup is the profile's alone
+    const release = [
+      ...(config.getPreset('release')?.flags || []),
+      ...use.filter((flag) => flag.startsWith('-flto') || flag.startsWith('-march=')),
+    ]
+    const extra = program.flags || []
+    const baselineOut = `.pgo/release/${program.name}`
+    // Both PGO passes must write the same output path: gcc names the
+    // .gcda file after it.
+    const pgoOut = `.pgo/pgo/${program.name}`
+    const profileDir = `.pgo/profile/${program.name}`
+
+    await fs.rm(join(options.projectPath, profileDir), { recursive: true, force: true })
+    await fs.mkdir(join(options.projectPath, profileDir), { recursive: true })
+
+    const train = await this.loadTrace(program, 'train', options)
+    const evaluation = await this.loadTrace(program, 'eval', options)
+
+    await this.build(program, baselineOut, [...release, ...extra], options)
+    await this.build(program, pgoOut, [...generate, `-fprofile-dir=${profileDir}`, ...extra], options)
+    const trainMs = await this.timeRun(pgoOut, train, options)
+    // Without a profile, -fprofile-use only warns and the result would be
+    // a plain LTO build reported as PGO.
+    const profiles = await fs.readdir(join(options.projectPath, profileDir))
+    if (!profiles.some((file) => file.endsWith('.gcda'))) {
+      throw new Error(`${program.name}: training wrote no .gcda profile to ${profileDir}`)
+    }
+    await this.build(program, pgoOut, [...use, `-fprofile-dir=${profileDir}`, ...extra], options)
+
+    const runs = options.runs || 5
+    const baselineTimes: number[] = []
+    const pgoTimes: number[] = []
+    // Interleaved so drift in machine load hits both sides alike
+    for (let i = 0; i < runs; i++) {
+      baselineTimes.push(await this.timeRun(baselineOut, evaluation, options))
+      pgoTimes.push(await this.timeRun(pgoOut, evaluation, options))
+    }
+    const baselineMs = this.median(baselineTimes)
+    const pgoMs = this.median(pgoTimes)
+
+    return {
+      name: program.name,
+      success: true,
+      baselineMs,
+      pgoMs,
+      speedup: pgoMs > 0 ? baselineMs / pgoMs : undefined,
+      trainMs,
+    }
+  }
+
+  /**
+   * Compile one program, throwing on failure
+   */
+  private async build(program: PgoProgram, outputFile: string, flags: string[], options: PgoOptions): Promise<void> {
+    const result = await getCompilerService().compile({
+      sourceFile: program.sourceFile,
+      outputFile,
+      flags,
+      cwd: options.projectPath,
+    })
+    if (!result.success) {
+      throw new Error(`${program.name}: build failed (${flags.join(' ')})\n${result.error || ''}`)
+    }
+  }
+
+  /**
+   * Recorded trace if the program names one, else a synthesized trace
+   * written under .pgo/traces for reruns and inspection
+   */
+  private async loadTrace(program: PgoProgram, kind: 'train' | 'eval', options: PgoOptions): Promise<string> {
+    const recorded = kind === 'train' ? program.trainTrace : program.evalTrace
+    if (recorded) {
+      return fs.readFile(join(options.projectPath, recorded), 'utf8')
+    }
+    // Training and evaluation use different seeds, so the profile is not
+    // scored on the exact input it was trained on.
+    const seed = (options.seed || 1) + (kind === 'eval' ? 7919 : 0)
+    const trace = this.synthesizeTrace(program, options.traceOps || 15000, seed)
+    await fs.writeFile(join(options.projectPath, '.pgo/traces', `${program.name}.${kind}.txt`), trace)
+    return trace
+  }
+
+  /**
+   * Seeded op mix following the program's menu
+   */
+  synthesizeTrace(program: PgoProgram, ops: number, seed: number): string {
+    const random = this.prng(seed)
+    const item = (max = 100000) => String(Math.floor(random() * max))
+    const tokens: string[] = []
+    let length = 0
+
+    for (let i = 0; i < program.preludeItems; i++) {
+      tokens.push(item())
+      length++
+    }
+    for (let i = 0; i < ops; i++) {
+      const allowed = program.ops.filter((op) => length >= (op.minLength || 0))
+      const total = allowed.reduce((sum, op) => sum + op.weight, 0)
+      let pick = random() * total
+      let op = allowed[allowed.length - 1]
+      for (const candidate of allowed) {
+        pick -= candidate.weight
+        if (pick < 0) {
+          op = candidate
+          break
+        }
+      }
+      tokens.push(String(op.choice))
+      for (let a = 0; a < (op.args || 0); a++) {
+        tokens.push(item(op.argMax))
+      }
+      length += op.delta || 0
+    }
+    // The programs spin on a failed scanf, so a trace must always exit.
+    tokens.push(String(program.exitChoice))
+    return tokens.join('\n') + '\n'
+  }
+
+  /**
+   * Run a binary with the trace on stdin; returns wall time in ms
+   */
+  private timeRun(binary: string, trace: string, options: PgoOptions): Promise<number> {
+    return new Promise((resolve, reject) => {
+      const start = process.hrtime.bigint()
+      const child = spawn(`./${binary}`, [], {
+        cwd: options.projectPath,
+        stdio: ['pipe', 'ignore', 'ignore'],
+      })
+      const timer = setTimeout(() => {
+        child.kill('SIGKILL')
+      }, options.timeoutMs || 120000)
+
+      child.on('close', (code, signal) => {
+        clearTimeout(timer)
+        const ms = Number(process.hrtime.bigint() - start) / 1e6
+        if (code === 0) {
+          resolve(ms)
+        } else {
+          reject(new Error(`${binary} exited with ${signal || code} after ${ms.toFixed(0)} ms`))
+        }
+      })
+      child.on('error', (error) => {
+        clearTimeout(timer)
+        reject(error)
+      })
+      // A program that exits early closes the pipe; its exit code decides.
+      child.stdin.on('error', () => {})
+      child.stdin.end(trace)
+    })
+  }
+
+  /**
+   * Speedup table, one row per program
+   */
+  formatReport(results: PgoProgramResult[]): string {
+    const lines = ['program                   lto ms    pgo ms  speedup']
+    for (const r of results) {
+      if (!r.success) {
+        lines.push(`${r.name.padEnd(20)}  failed: ${r.error?.split('\n')[0]}`)
+        continue
+      }
+      lines.push(
+        `${r.name.padEnd(20)}  ${r.baselineMs!.toFixed(1).padStart(10)}  ${r.pgoMs!.toFixed(1).padStart(8)}  ${(r.speedup || 0).toFixed(2).padStart(6)}x`
+      )
+    }
+    return lines.join('\n')
+  }
+
+  private median(values: number[]): number {
+    const sorted = [...values].sort((a, b) => a - b)
+    const mid = Math.floor(sorted.length / 2)
+    return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2
+  }
+
+  /**
+   * mulberry32: small, fast, and the same trace for the same seed
+   */
+  private prng(seed: number): () => number {
+    let a = seed >>> 0
+    return () => {
+      a = (a + 0x6d2b79f5) >>> 0
+      let t = a
+      t = Math.imul(t ^ (t >>> 15), t | 1)
+      t ^= t + Math.imul(t ^ (t >>> 7), t | 61)
+      return ((t ^ (t >>> 14)) >>> 0) / 4294967296
+    }
+  }
+}
+
+/**
+ * Get PGO Pipeline instance
+ */
+export function getPgoPipeline(): PgoPipeline {
+  return PgoPipeline.getInstance()
+}
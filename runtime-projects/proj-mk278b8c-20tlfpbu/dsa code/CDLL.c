@@ -1,12 +1,22 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"retire.h"
+#include"list_stats.h"
+#include"display.h"
+#include"list_probes.h"
 struct Node{
     int info;
     struct Node* prev;
     struct Node* next;
 };
-struct Node* create_cdll(struct Node* start){
-    struct Node*new,*ptr;
+//A CDLL is its start pointer plus the running stats of its items;
+//stats.length is the node count.
+struct CDLL{
+    struct Node* start;
+    struct ListStats stats;
+};
+void create_cdll(struct CDLL* list){
+    struct Node*new;
     int item;
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
@@ -16,31 +26,64 @@ struct Node* create_cdll(struct Node* start){
         printf("enter item to create the node ..");
         scanf("%d",&item);
         new->info=item;
-        start=new;
-        new->prev=start;
-        new->next=start;
+        stats_add(&list->stats,item);
+        new->prev=new;
+        new->next=new;
+        list->start=new;
     }
-    return (start);
 }
-void traverse(struct Node * start){
+void traverse(struct CDLL* list){
+    struct Node* start=list->start;
     if(start==NULL){
         printf("OVERFLOW");
     }
     else{
         struct Node* ptr=start;
         printf("CDLL contains ...");
-        printf("%d\t",ptr->info);
+        out_int(ptr->info);
         ptr=ptr->next;
         while(ptr!=start){
-            printf("%d\t",ptr->info);
+            out_int(ptr->info);
             ptr=ptr->next;
         }
+        out_dump_end();
     }
 
 }
-struct Node* insert_beg(struct Node* start){
-    struct Node* new,*ptr;
-    int item;
+//First and last K items, length and checksum; shown after each op.
+//The last K are reached backwards from start->prev, so this costs O(K)
+//whatever the length.
+void display(struct CDLL* list){
+    struct Node* start=list->start,*ptr;
+    int i,n=list->stats.length,head,tail;
+    if(start==NULL){
+        printf("OVERFLOW");
+        return;
+    }
+    printf("CDLL contains ...");
+    head=(window_k==0 || n<=2*window_k)?n:window_k;
+    tail=n-head;
+    ptr=start;
+    for(i=0;i<head;i++){
+        out_int(ptr->info);
+        ptr=ptr->next;
+    }
+    if(tail>0){
+        window_gap(tail-window_k);
+        ptr=start;
+        for(i=0;i<window_k;i++)
+            ptr=ptr->prev;
+        for(i=0;i<window_k;i++){
+            out_int(ptr->info);
+            ptr=ptr->next;
+        }
+    }
+    window_footer(&list->stats);
+}
+void insert_beg(struct CDLL* list){
+    struct Node* new,*start=list->start,*ptr;
+    int item=0;
+    LIST_PROBE3(insert_beg_entry,&list->stats,list->stats.length,0);
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
         printf("OVERFLOW");
@@ -49,8 +92,9 @@ struct Node* insert_beg(struct Node* start){
         printf("enter item to be inserted");
         scanf("%d",&item);
         new->info=item;
-        new->next=NULL;
-        new->prev=NULL;
+        new->next=new;
+        new->prev=new;
+        stats_add(&list->stats,item);
         if(start==NULL){
             start=new;
         }
@@ -63,11 +107,13 @@ struct Node* insert_beg(struct Node* start){
             start=new;
         }
     }
-    return(start);
+    list->start=start;
+    LIST_PROBE3(insert_beg_return,&list->stats,list->stats.length,item);
 }
-struct Node* insert_end(struct Node* start){
-    struct Node*new,*ptr;
-    int item;
+void insert_end(struct CDLL* list){
+    struct Node*new,*start=list->start,*ptr;
+    int item=0;
+    LIST_PROBE3(insert_end_entry,&list->stats,list->stats.length,0);
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
         printf("OVERFLOW");
@@ -76,8 +122,9 @@ struct Node* insert_end(struct Node* start){
         printf("enter item to be inserted");
         scanf("%d",&item);
         new->info=item;
-        new->next=NULL;
-        new->prev=NULL;
+        new->next=new;
+        new->prev=new;
+        stats_add(&list->stats,item);
         if(start==NULL){
             start=new;
         }
@@ -89,64 +136,175 @@ struct Node* insert_end(struct Node* start){
             start->prev=new;
         }
     }
-    return(start);
+    list->start=start;
+    LIST_PROBE3(insert_end_return,&list->stats,list->stats.length,item);
 }
-struct Node* delete_beg(struct Node*start){
-    struct Node* ptr;
+void delete_beg(struct CDLL* list){
+    struct Node*start=list->start,*ptr;
+    int item=0;
+    LIST_PROBE3(delete_beg_entry,&list->stats,list->stats.length,0);
     if(start==NULL){
         printf("UNDERFLOW");
     }
     else{
         ptr=start;
-        printf("deleted item is: %d",ptr->info);
-        start=ptr->next;
-        ptr->prev->next=ptr->next;
-        ptr->next->prev=ptr->prev;
-        free(ptr);
+        item=ptr->info;
+        printf("deleted item is: %d",item);
+        stats_remove(&list->stats,item);
+        if(ptr->next==ptr){
+            start=NULL; //it was the only node
+        }
+        else{
+            start=ptr->next;
+            ptr->prev->next=ptr->next;
+            ptr->next->prev=ptr->prev;
+        }
+        retire(ptr);
 
     }
-    return(start);
+    list->start=start;
+    LIST_PROBE3(delete_beg_return,&list->stats,list->stats.length,item);
 }
-struct Node* delete_end(struct Node* start){
-    struct Node* ptr;
+void delete_end(struct CDLL* list){
+    struct Node* start=list->start,*ptr;
+    int item=0;
+    LIST_PROBE3(delete_end_entry,&list->stats,list->stats.length,0);
     if(start==NULL){
         printf("OVERFLOW");
     }
     else{
         ptr=start->prev;
-        printf("deleted item is:%d",ptr->info);
-        ptr->prev->next=start;
-        start->prev=ptr->prev;
-        free(ptr);
+        item=ptr->info;
+        printf("deleted item is:%d",item);
+        stats_remove(&list->stats,item);
+        if(ptr==start){
+            start=NULL; //it was the only node
+        }
+        else{
+            ptr->prev->next=start;
+            start->prev=ptr->prev;
+        }
+        retire(ptr);
     }
-    return(start);
+    list->start=start;
+    LIST_PROBE3(delete_end_return,&list->stats,list->stats.length,item);
+}
+//Moves start k nodes forward (k<0 moves it back along prev). Only the
+//start pointer changes: no node is freed, allocated or relinked. k is
+//taken modulo the length and walked whichever way round is shorter, so
+//this costs at most length/2 steps.
+void rotate(struct CDLL* list,int k){
+    struct Node* start=list->start;
+    int n=list->stats.length;
+    if(start==NULL || n==0)
+        return;
+    k%=n;
+    if(k<0)
+        k+=n;
+    if(k<=n/2){
+        for(;k>0;k--)
+            start=start->next;
+    }
+    else{
+        for(k=n-k;k>0;k--)
+            start=start->prev;
+    }
+    list->start=start;
+}
+//Round-robin cursor: start is whose turn it is.
+//weight(info) gives a node that many turns in a row (NULL means 1),
+//skip(info) non-zero passes over a node (NULL means never).
+//served counts the turns start has had; every op that changes start
+//resets it, so a new start begins with its full weight.
+struct RR{
+    int served;
+    int (*weight)(int info);
+    int (*skip)(int info);
+};
+struct Node* rr_next(struct CDLL* list,struct RR* rr){
+    struct Node* first;
+    int turns,lap=0;
+    if(list->start==NULL){
+        return NULL;
+    }
+    first=list->start;
+    //Two laps at most: the current node may be used up, then every
+    //other node may be skipped before coming back round to it.
+    while(lap<2){
+        turns=rr->weight==NULL?1:rr->weight(list->start->info);
+        if((rr->skip==NULL || !rr->skip(list->start->info)) && rr->served<turns){
+            rr->served++;
+            return list->start;
+        }
+        list->start=list->start->next;
+        rr->served=0;
+        if(list->start==first)
+            lap++;
+    }
+    return NULL;
+}
+//O(1) unless a delete took the min or max; then one rescan.
+void show_stats(struct CDLL* list){
+    struct Node* ptr=list->start;
+    if(list->stats.extremes_stale){
+        stats_rescan_begin(&list->stats);
+        do{
+            stats_rescan(&list->stats,ptr->info);
+            ptr=ptr->next;
+        }while(ptr!=list->start);
+    }
+    stats_print(&list->stats);
 }
 int main(){
-    struct Node* start=NULL;
-    int item,choice;
-    start=create_cdll(start);
+    struct CDLL list;
+    struct RR rr={0,NULL,NULL};
+    struct Node* turn;
+    int choice,k;
+    list.start=NULL;
+    stats_reset(&list.stats);
+    window_init();
+    create_cdll(&list);
     do{
-        printf("\npress\n1->insert at beg\n2->insert at end\n3->delete at beg\n4->delete at end\n5->traverse\n6->exit\n");
+        retire_flush();
+        out_sync();
+        printf("\npress\n1->insert at beg\n2->insert at end\n3->delete at beg\n4->delete at end\n5->traverse\n6->rotate\n7->next turn\n8->stats\n9->exit\n");
         printf("enter your choice");
         scanf("%d",&choice);
         switch(choice){
-            case 1:start=insert_beg(start);
-                   traverse(start);
+            case 1:insert_beg(&list);
+                   rr.served=0;
+                   display(&list);
+                   break;
+            case 2:insert_end(&list);
+                   display(&list);
+                   break;
+            case 3:delete_beg(&list);
+                   rr.served=0;
+                   display(&list);
+                   break;
+            case 4:delete_end(&list);
+                   rr.served=0;
+                   display(&list);
                    break;
-            case 2:start=insert_end(start);
-                   traverse(start);
+            case 5:traverse(&list);
                    break;
-            case 3:start=delete_beg(start);
-                   traverse(start);
+            case 6:printf("enter k to rotate by");
+                   scanf("%d",&k);
+                   rotate(&list,k);
+                   rr.served=0;
+                   display(&list);
                    break;
-            case 4:start=delete_end(start);
-                   traverse(start);
+            case 7:turn=rr_next(&list,&rr);
+                   if(turn==NULL)
+                       printf("no node to serve");
+                   else
+                       printf("turn of %d",turn->info);
                    break;
-            case 5:traverse(start);
+            case 8:show_stats(&list);
                    break;
-            case 6:exit(0);
+            case 9:exit(0);
                    break;
             default:printf("invalid choice");
         }
-    }while(choice<7);
+    }while(choice<10);
 }
\ No newline at end of file
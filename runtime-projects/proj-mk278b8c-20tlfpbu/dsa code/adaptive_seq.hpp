@@ -0,0 +1,465 @@
+// Sequence with the SLL op set that picks its own representation:
+//
+//   array     std::vector; best while small (insert_beg is a short memmove)
+//   unrolled  unrolled_list; cheap at both ends at any size
+//   indexed   deque + skip list of (value, seq); search is O(log n)
+//
+// Ops are counted in fixed windows. A migration needs the window to
+// be past an enter threshold and a later one needs it back past a lower
+// exit threshold, and at least max(window, n/4) ops must pass between
+// migrations so each O(n) rebuild is paid for by the ops that caused it.
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "list_traits.hpp"
+#include "unrolled_list.hpp"
+
+namespace dsa {
+
+namespace adaptive_detail {
+
+// Skip list of (key, seq) pairs ordered by key then seq, so the first hit
+// for a key is its earliest live occurrence.
+template <class K>
+class skip_index
+{
+	static constexpr int max_level = 24;
+
+	struct node
+	{
+		K key;
+		std::int64_t seq;
+		int level;
+		node ** next; // `level` entries, placed right after the node
+	};
+
+public:
+	skip_index() : head_(alloc(K(), 0, max_level)) {}
+	~skip_index()
+	{
+		clear();
+		release(head_);
+	}
+	skip_index(const skip_index &) = delete;
+	skip_index & operator=(const skip_index &) = delete;
+
+	void insert(const K & key, std::int64_t seq)
+	{
+		node * update[max_level];
+		node * x = seek(key, seq, update);
+		(void)x;
+		int lvl = random_level();
+		if (lvl > level_)
+		{
+			for (int i = level_; i < lvl; i++)
+				update[i] = head_;
+			level_ = lvl;
+		}
+		node * n = alloc(key, seq, lvl);
+		for (int i = 0; i < lvl; i++)
+		{
+			n->next[i] = update[i]->next[i];
+			update[i]->next[i] = n;
+		}
+	}
+
+	void erase(const K & key, std::int64_t seq)
+	{
+		node * update[max_level];
+		node * x = seek(key, seq, update);
+		if (x == nullptr || x->seq != seq || less(key, x->key) || less(x->key, key))
+			return;
+		for (int i = 0; i < level_ && update[i]->next[i] == x; i++)
+			update[i]->next[i] = x->next[i];
+		release(x);
+		while (level_ > 1 && head_->next[level_ - 1] == nullptr)
+			level_--;
+	}
+
+	// Lowest seq stored for key, or false.
+	bool find_first(const K & key, std::int64_t & seq) const
+	{
+		node * x = head_;
+		for (int i = level_ - 1; i >= 0; i--)
+			while (x->next[i] && less(x->next[i]->key, key))
+				x = x->next[i];
+		x = x->next[0];
+		if (x == nullptr || less(key, x->key))
+			return false;
+		seq = x->seq;
+		return true;
+	}
+
+	void clear()
+	{
+		node * x = head_->next[0];
+		while (x)
+		{
+			node * n = x->next[0];
+			release(x);
+			x = n;
+		}
+		for (int i = 0; i < max_level; i++)
+			head_->next[i] = nullptr;
+		level_ = 1;
+	}
+
+private:
+	static bool less(const K & a, const K & b) { return a < b; }
+
+	node * seek(const K & key, std::int64_t seq, node ** update) const
+	{
+		node * x = head_;
+		for (int i = level_ - 1; i >= 0; i--)
+		{
+			while (x->next[i] && (less(x->next[i]->key, key) || (!less(key, x->next[i]->key) && x->next[i]->seq < seq)))
+				x = x->next[i];
+			update[i] = x;
+		}
+		return x->next[0];
+	}
+
+	int random_level()
+	{
+		int lvl = 1;
+		std::uint32_t r = rng_();
+		while (lvl < max_level && (r & 3) == 0)
+		{
+			lvl++;
+			r >>= 2;
+		}
+		return lvl;
+	}
+
+	// One block per node: the node, then its tower of `lvl` next pointers
+	// (sizeof(node) is a multiple of alignof(node *) as node holds one).
+	static node * alloc(const K & key, std::int64_t seq, int lvl)
+	{
+		char * raw = static_cast<char *>(::operator new(sizeof(node) + sizeof(node *) * std::size_t(lvl)));
+		node ** tower = ::new (static_cast<void *>(raw + sizeof(node))) node *[lvl]();
+		try
+		{
+			return ::new (static_cast<void *>(raw)) node{key, seq, lvl, tower};
+		}
+		catch (...)
+		{
+			::operator delete(raw);
+			throw;
+		}
+	}
+
+	static void release(node * n)
+	{
+		n->~node();
+		::operator delete(static_cast<void *>(n));
+	}
+
+	node * head_;
+	int level_ = 1;
+	std::minstd_rand rng_{0x5eed};
+};
+
+} // namespace adaptive_detail
+
+enum class seq_form { array, unrolled, indexed };
+
+struct adaptive_policy
+{
+	std::size_t window = 1024;        // ops per decision window
+	std::size_t array_enter = 64;     // go array at or below this size...
+	std::size_t array_exit = 256;     // ...and leave it above this one
+	double front_exit = 0.10;         // array also left when insert_beg share exceeds this
+	double search_enter = 0.50;       // go indexed when search share reaches this...
+	double search_exit = 0.20;        // ...and leave it below this one
+	std::size_t indexed_min = 512;    // smaller lists never bother with an index
+};
+
+struct adaptive_stats
+{
+	seq_form form = seq_form::array;
+	std::size_t migrations = 0;
+	std::size_t to_array = 0, to_unrolled = 0, to_indexed = 0;
+	std::size_t migrated_items = 0;     // items copied by all migrations
+	std::uint64_t migration_ns = 0;     // wall time spent migrating
+	std::size_t inserts = 0, deletes = 0, searches = 0, reorders = 0;
+};
+
+template <class T, std::size_t B = 64>
+class adaptive_seq
+{
+public:
+	using value_type = T;
+
+	explicit adaptive_seq(adaptive_policy policy = adaptive_policy()) : policy_(policy) {}
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+	seq_form form() const { return stats_.form; }
+	const adaptive_stats & stats() const { return stats_; }
+
+	list_status insert_beg(T item)
+	{
+		note(win_front_);
+		stats_.inserts++;
+		list_status st = list_status::ok;
+		switch (stats_.form)
+		{
+		case seq_form::array: arr_.insert(arr_.begin(), std::move(item)); break;
+		case seq_form::unrolled: st = unr_.insert_beg(std::move(item)); break;
+		case seq_form::indexed:
+			idx_.insert(item, --front_seq_);
+			seq_.push_front(std::move(item));
+			break;
+		}
+		if (st == list_status::ok)
+			len_++;
+		return st;
+	}
+
+	list_status insert_end(T item)
+	{
+		note(win_other_);
+		stats_.inserts++;
+		list_status st = list_status::ok;
+		switch (stats_.form)
+		{
+		case seq_form::array: arr_.push_back(std::move(item)); break;
+		case seq_form::unrolled: st = unr_.insert_end(std::move(item)); break;
+		case seq_form::indexed:
+			idx_.insert(item, front_seq_ + std::int64_t(seq_.size()));
+			seq_.push_back(std::move(item));
+			break;
+		}
+		if (st == list_status::ok)
+			len_++;
+		return st;
+	}
+
+	list_status delete_beg(T * out = nullptr)
+	{
+		if (len_ == 0)
+			return list_status::underflow;
+		note(win_other_);
+		stats_.deletes++;
+		switch (stats_.form)
+		{
+		case seq_form::array:
+			if (out)
+				*out = std::move(arr_.front());
+			arr_.erase(arr_.begin());
+			break;
+		case seq_form::unrolled: unr_.delete_beg(out); break;
+		case seq_form::indexed:
+			idx_.erase(seq_.front(), front_seq_++);
+			if (out)
+				*out = std::move(seq_.front());
+			seq_.pop_front();
+			break;
+		}
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_end(T * out = nullptr)
+	{
+		if (len_ == 0)
+			return list_status::underflow;
+		note(win_other_);
+		stats_.deletes++;
+		switch (stats_.form)
+		{
+		case seq_form::array:
+			if (out)
+				*out = std::move(arr_.back());
+			arr_.pop_back();
+			break;
+		case seq_form::unrolled: unr_.delete_end(out); break;
+		case seq_form::indexed:
+			idx_.erase(seq_.back(), front_seq_ + std::int64_t(seq_.size()) - 1);
+			if (out)
+				*out = std::move(seq_.back());
+			seq_.pop_back();
+			break;
+		}
+		len_--;
+		return list_status::ok;
+	}
+
+	// 1-based position like searching_sll, or 0 when absent.
+	std::size_t search(const T & item)
+	{
+		note(win_search_);
+		stats_.searches++;
+		switch (stats_.form)
+		{
+		case seq_form::array:
+		{
+			auto it = std::find(arr_.begin(), arr_.end(), item);
+			return it == arr_.end() ? 0 : std::size_t(it - arr_.begin()) + 1;
+		}
+		case seq_form::unrolled: return unr_.search(item);
+		case seq_form::indexed:
+		{
+			std::int64_t seq;
+			if (!idx_.find_first(item, seq))
+				return 0;
+			return std::size_t(seq - front_seq_) + 1;
+		}
+		}
+		return 0;
+	}
+
+	template <class Less = std::less<>>
+	void sort(Less less = Less())
+	{
+		note(win_other_);
+		stats_.reorders++;
+		std::vector<T> all = drain();
+		std::stable_sort(all.begin(), all.end(), less);
+		fill(std::move(all));
+	}
+
+	void reverse()
+	{
+		note(win_other_);
+		stats_.reorders++;
+		std::vector<T> all = drain();
+		std::reverse(all.begin(), all.end());
+		fill(std::move(all));
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		switch (stats_.form)
+		{
+		case seq_form::array:
+			for (const T & v : arr_)
+				f(v);
+			break;
+		case seq_form::unrolled: unr_.for_each(f); break;
+		case seq_form::indexed:
+			for (const T & v : seq_)
+				f(v);
+			break;
+		}
+	}
+
+	// Forces a representation, e.g. after a bulk load with a known workload.
+	void migrate(seq_form to)
+	{
+		if (to == stats_.form)
+			return;
+		auto t0 = std::chrono::steady_clock::now();
+		std::vector<T> all = drain();
+		stats_.migrated_items += all.size();
+		stats_.form = to;
+		fill(std::move(all));
+		stats_.migration_ns += std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - t0).count());
+		stats_.migrations++;
+		(to == seq_form::array ? stats_.to_array : to == seq_form::unrolled ? stats_.to_unrolled : stats_.to_indexed)++;
+		since_migration_ = 0;
+	}
+
+private:
+	void note(std::size_t & bucket)
+	{
+		bucket++;
+		since_migration_++;
+		if (++win_ops_ < policy_.window)
+			return;
+		decide();
+		win_ops_ = win_front_ = win_search_ = win_other_ = 0;
+	}
+
+	void decide()
+	{
+		if (since_migration_ < std::max(policy_.window, len_ / 4))
+			return;
+		double ops = double(win_ops_);
+		double search = win_search_ / ops, front = win_front_ / ops;
+		seq_form cur = stats_.form, want = cur;
+		switch (cur)
+		{
+		case seq_form::array:
+			if (len_ >= policy_.indexed_min && search >= policy_.search_enter)
+				want = seq_form::indexed;
+			else if (len_ > policy_.array_exit || front > policy_.front_exit)
+				want = seq_form::unrolled;
+			break;
+		case seq_form::unrolled:
+			if (len_ >= policy_.indexed_min && search >= policy_.search_enter)
+				want = seq_form::indexed;
+			else if (len_ <= policy_.array_enter && front <= policy_.front_exit)
+				want = seq_form::array;
+			break;
+		case seq_form::indexed:
+			if (search < policy_.search_exit || len_ < policy_.indexed_min / 2)
+				want = len_ <= policy_.array_enter ? seq_form::array : seq_form::unrolled;
+			break;
+		}
+		if (want != cur)
+			migrate(want);
+	}
+
+	std::vector<T> drain()
+	{
+		std::vector<T> all;
+		all.reserve(len_);
+		switch (stats_.form)
+		{
+		case seq_form::array: all.swap(arr_); break;
+		case seq_form::unrolled:
+			unr_.for_each([&all](const T & v) { all.push_back(v); });
+			unr_.clear();
+			break;
+		case seq_form::indexed:
+			all.assign(std::make_move_iterator(seq_.begin()), std::make_move_iterator(seq_.end()));
+			seq_.clear();
+			idx_.clear();
+			front_seq_ = 0;
+			break;
+		}
+		return all;
+	}
+
+	void fill(std::vector<T> all)
+	{
+		switch (stats_.form)
+		{
+		case seq_form::array: arr_ = std::move(all); break;
+		case seq_form::unrolled:
+			for (T & v : all)
+				unr_.insert_end(std::move(v));
+			break;
+		case seq_form::indexed:
+			front_seq_ = 0;
+			for (std::size_t i = 0; i < all.size(); i++)
+				idx_.insert(all[i], std::int64_t(i));
+			seq_.assign(std::make_move_iterator(all.begin()), std::make_move_iterator(all.end()));
+			break;
+		}
+	}
+
+	adaptive_policy policy_;
+	adaptive_stats stats_;
+	std::size_t len_ = 0;
+	std::size_t win_ops_ = 0, win_front_ = 0, win_search_ = 0, win_other_ = 0;
+	std::size_t since_migration_ = 0;
+
+	std::vector<T> arr_;
+	unrolled_list<T, B> unr_;
+	std::deque<T> seq_;
+	std::int64_t front_seq_ = 0; // seq of seq_.front(); positions are seq - front_seq_
+	adaptive_detail::skip_index<T> idx_;
+};
+
+} // namespace dsa
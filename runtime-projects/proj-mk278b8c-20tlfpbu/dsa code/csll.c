@@ -1,173 +1,279 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"retire.h"
+#include"list_stats.h"
+#include"display.h"
+#include"list_probes.h"
 struct Node{
     int info;
     struct Node*link;
 };
-struct Node*  create_csll(struct Node* start){
+//CSLL is kept by its tail only: tail->link is the first node,
+//so both ends are reachable in O(1) without walking the ring.
+//stats.length is the node count.
+struct CSLL{
+    struct Node* tail;
+    struct ListStats stats;
+};
+struct Node* get_node(){
     struct Node* new;
     int item;
     new=(struct Node*)malloc(sizeof(struct Node));
-    printf("enter item to start ...");
-    scanf("%d",&item);
     if(new==NULL){
         printf("OVERFLOW");
     }
     else{
+        printf("enter item to be inserted");
+        scanf("%d",&item);
         new->info=item;
-        new->link=start;
-        start=new;
+        new->link=new;
     }
-    return start;
+    return new;
 }
-struct Node* insert_beg(struct Node* start){
-    struct Node* new,*ptr;
+void create_csll(struct CSLL* list){
+    struct Node* new;
     int item;
     new=(struct Node*)malloc(sizeof(struct Node));
-   
+    printf("enter item to start ...");
+    scanf("%d",&item);
     if(new==NULL){
         printf("OVERFLOW");
     }
     else{
-        printf("enter item to be inserted");
-        scanf("%d",&item);
         new->info=item;
-        new->link=NULL;
-        if(start==NULL){
-            start=new;
-            new->link=start;
+        new->link=new;
+        list->tail=new;
+        stats_add(&list->stats,item);
+    }
+}
+void insert_beg(struct CSLL* list){
+    struct Node* new;
+    LIST_PROBE3(insert_beg_entry,&list->stats,list->stats.length,0);
+    new=get_node();
+    if(new!=NULL){
+        if(list->tail!=NULL){
+            new->link=list->tail->link;
+            list->tail->link=new;
         }
         else{
-            for(ptr=start;ptr->link!=start;ptr=ptr->link){
-                ptr->link=new;
-                new->link=start;
-                start=new;
-            }
+            list->tail=new;
         }
+        stats_add(&list->stats,new->info);
     }
-   
-    return start;
+    LIST_PROBE3(insert_beg_return,&list->stats,list->stats.length,new!=NULL?new->info:0);
 }
-struct Node*  insert_end(struct Node* start){
-    struct Node* ptr,*new;
-    int item;
-    new=(struct Node *)malloc(sizeof(struct Node));
-    
-    if(new==NULL){
-        printf("OVERFLOW");
-    }
-    else{
-        printf("enter item to be inserted");
-        scanf("%d",&item);
-        new->info=item;
-        new->link=NULL;
-        if(start==NULL){
-            start=new;
-            new->link=start;
-        }
-        else{
-            while(ptr->link!=start){
-                ptr=ptr->link;
-            }
-            ptr->link=new;
-            new->link=start;
+void insert_end(struct CSLL* list){
+    struct Node* new;
+    LIST_PROBE3(insert_end_entry,&list->stats,list->stats.length,0);
+    new=get_node();
+    if(new!=NULL){
+        if(list->tail!=NULL){
+            new->link=list->tail->link;
+            list->tail->link=new;
         }
-      
+        list->tail=new;
+        stats_add(&list->stats,new->info);
     }
-    
-    return start;
+    LIST_PROBE3(insert_end_return,&list->stats,list->stats.length,new!=NULL?new->info:0);
 }
-struct Node* delete_beg(struct Node* start){
+void delete_beg(struct CSLL* list){
     struct Node* ptr;
-     if(start==NULL){
+    int item=0;
+    LIST_PROBE3(delete_beg_entry,&list->stats,list->stats.length,0);
+    if(list->tail==NULL){
         printf("UNDERflow");
-     }
-     else{
-        ptr=start;
-        while(ptr->link!=NULL){
-            ptr=ptr->link;
-
-
+    }
+    else{
+        ptr=list->tail->link;
+        item=ptr->info;
+        printf("deleted item is %d",item);
+        if(ptr==list->tail){
+            list->tail=NULL;
         }
-        ptr->link=start->link;
-        ptr=start;
-        printf("deleted item is %d",ptr->info);
-      
-     }
-        
-        return start;
+        else{
+            list->tail->link=ptr->link;
+        }
+        stats_remove(&list->stats,item);
+        retire(ptr);
+    }
+    LIST_PROBE3(delete_beg_return,&list->stats,list->stats.length,item);
 }
-struct Node* delete_end(struct Node* start){
+//Needs the node before the tail, so this one still walks the ring.
+void delete_end(struct CSLL* list){
     struct Node* ptr,*prev;
-    if(start==NULL){
+    int item=0;
+    LIST_PROBE3(delete_end_entry,&list->stats,list->stats.length,0);
+    if(list->tail==NULL){
         printf("UNDERFLOW");
     }
     else{
-        ptr=start;
-        while(ptr->link!=start){
-            prev=ptr;
-            ptr=ptr->link;
+        ptr=list->tail;
+        prev=ptr->link;
+        while(prev->link!=ptr){
+            prev=prev->link;
         }
-        prev->link=start;
-        printf("deleted items are %d",ptr->info);
-        free(ptr);
-      
-
-
+        LIST_PROBE_WALK(&list->stats,list->stats.length-2,LIST_WALK_DELETE_END); //head to the node before tail
+        item=ptr->info;
+        printf("deleted items are %d",item);
+        if(prev==ptr){
+            list->tail=NULL;
+        }
+        else{
+            prev->link=ptr->link;
+            list->tail=prev;
+        }
+        stats_remove(&list->stats,item);
+        retire(ptr);
     }
-    return start;
+    LIST_PROBE3(delete_end_return,&list->stats,list->stats.length,item);
+}
+//Moves the head k nodes forward (k<0 moves it back). Only the tail
+//pointer changes: no node is freed, allocated or relinked.
+void rotate(struct CSLL* list,int k){
+    int i;
+    if(list->tail==NULL)
+        return;
+    k%=list->stats.length;
+    if(k<0)
+        k+=list->stats.length;
+    for(i=0;i<k;i++)
+        list->tail=list->tail->link;
 }
-void traverse(struct Node *start)
+//Round-robin cursor: the head of the ring is whose turn it is.
+//weight(info) gives a node that many turns in a row (NULL means 1),
+//skip(info) non-zero passes over a node (NULL means never).
+//served counts the turns the head has had; every op that changes the head
+//resets it, so a new head starts with its full weight.
+struct RR{
+    int served;
+    int (*weight)(int info);
+    int (*skip)(int info);
+};
+struct Node* rr_next(struct CSLL* list,struct RR* rr){
+    struct Node* head;
+    int tries,turns;
+    if(list->tail==NULL)
+        return NULL;
+    for(tries=0;tries<=list->stats.length;tries++){
+        head=list->tail->link;
+        turns=rr->weight==NULL?1:rr->weight(head->info);
+        if((rr->skip==NULL || !rr->skip(head->info)) && rr->served<turns){
+            rr->served++;
+            return head;
+        }
+        list->tail=head;
+        rr->served=0;
+    }
+    return NULL;
+}
+void traverse(struct CSLL* list)
 {
-    struct Node * ptr = start;
-    if(start==NULL)
+    struct Node * ptr;
+    if(list->tail==NULL)
         printf("\nEmpty CSLL.\n");
     else
     {
-        printf("\nContent of CSLL:\n");
-        printf("%d\t",ptr->info);//Print 1st node information.
-        ptr=ptr->link;
-        while(ptr!=start)
+        printf("\nContent of CSLL (%d nodes):\n",list->stats.length);
+        ptr=list->tail->link;
+        do
         {
-            printf("%d\t",ptr->info);
+            out_int(ptr->info);
             ptr=ptr->link;
-        }
+        }while(ptr!=list->tail->link);
+        out_dump_end();
+    }
+}
+//First and last K items, length and checksum; shown after each op.
+void display(struct CSLL* list){
+    struct Node* ptr;
+    struct Window w;
+    if(list->tail==NULL){
+        printf("\nEmpty CSLL.\n");
+        return;
+    }
+    printf("\nContent of CSLL:\n");
+    window_begin(&w);
+    ptr=list->tail;
+    do{
+        ptr=ptr->link;
+        window_item(&w,ptr->info);
+    }while(ptr!=list->tail);
+    window_end(&w,&list->stats);
+}
+//O(1) unless a delete took the min or max; then one rescan.
+void show_stats(struct CSLL* list){
+    struct Node* ptr;
+    if(list->stats.extremes_stale){
+        stats_rescan_begin(&list->stats);
+        ptr=list->tail;
+        do{
+            ptr=ptr->link;
+            stats_rescan(&list->stats,ptr->info);
+        }while(ptr!=list->tail);
     }
+    stats_print(&list->stats);
 }
 int main(){
-    struct Node* start=NULL;
-    int item,choice;
-    start=create_csll(start);
+    struct CSLL list;
+    struct RR rr={0,NULL,NULL};
+    struct Node* turn;
+    int choice,k;
+    list.tail=NULL;
+    stats_reset(&list.stats);
+    window_init();
+    create_csll(&list);
     do{
-        printf("\n MENU\n1.insert at beg\n2.insert at end\n3.delete at beg\n4.delete at end\n5.traverse\n6.exit\n");
+        retire_flush();
+        out_sync();
+        printf("\n MENU\n1.insert at beg\n2.insert at end\n3.delete at beg\n4.delete at end\n5.traverse\n6.rotate\n7.next turn\n8.stats\n9.exit\n");
         printf("enter your choice");
         scanf("%d",&choice);
         switch(choice){
 
             case 1:
-                start=insert_beg(start);
-                traverse(start);
+                insert_beg(&list);
+                rr.served=0;
+                display(&list);
                 break;
             case 2:
-                start=insert_end(start);
-                traverse(start);
+                insert_end(&list);
+                display(&list);
                 break;
             case 3:
-                start=delete_beg(start);
-                traverse(start);
+                delete_beg(&list);
+                rr.served=0;
+                display(&list);
                 break;
             case 4:
-                start=delete_end(start);
-                traverse(start);
+                delete_end(&list);
+                rr.served=0;
+                display(&list);
                 break;
             case 5:
-                traverse(start);
+                traverse(&list);
                 break;
             case 6:
+                printf("enter k to rotate by");
+                scanf("%d",&k);
+                rotate(&list,k);
+                rr.served=0;
+                display(&list);
+                break;
+            case 7:
+                turn=rr_next(&list,&rr);
+                if(turn==NULL)
+                    printf("no node to serve");
+                else
+                    printf("turn of %d",turn->info);
+                break;
+            case 8:
+                show_stats(&list);
+                break;
+            case 9:
                 exit(0);
                 break;
             default:
                 printf("invalid choice");
         }
-    }while(choice!=7);
+    }while(choice!=10);
 }
@@ -0,0 +1,240 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"list_stats.h"
+#include"list_probes.h"
+//Output for the menu programs.
+//After an operation only a window is shown: the first and last K items,
+//the length and the checksum, so one op on a million-node list prints a
+//few lines instead of a million numbers. The traversal menu entry still
+//dumps everything, through out_int()/out_dump_end(), which format into
+//large buffers instead of calling printf per item.
+//K comes from the LIST_WINDOW environment variable (default 8, at most
+//WINDOW_MAX). LIST_WINDOW=0 shows the whole list after every op again.
+//Build with -DDISPLAY_ASYNC -pthread to hand full dumps to a writer
+//thread: traversal formats into a small pool of buffers and returns as
+//soon as the last one is queued, while the writer thread does the
+//write()s. Programs call out_sync() before printing anything else, such
+//as at the top of the menu loop. The output_stall(inflight) probe fires
+//when a dump outruns the writer and has to wait for a free buffer.
+#define WINDOW_MAX 64
+#define OUT_SIZE (1<<16)
+static int window_k=8;
+static int out_len=0;
+#ifdef DISPLAY_ASYNC
+#include<errno.h>
+#include<pthread.h>
+#include<semaphore.h>
+#include<stdatomic.h>
+#include<unistd.h>
+#define OUT_BUFFERS 4
+static char out_pool[OUT_BUFFERS][OUT_SIZE];
+static int out_used[OUT_BUFFERS];
+static char* out_buf=out_pool[0];
+static int out_cur=0;
+//Buffer indexes travel in two single-producer single-consumer rings:
+//full ones from the program to the writer, written ones back. Only the
+//head and tail counters are shared. The semaphores are there to sleep
+//on: out_free_sem makes the program wait when every buffer is queued.
+struct OutRing{
+    int slot[OUT_BUFFERS];
+    atomic_uint head,tail;
+};
+static struct OutRing out_full,out_free;
+static sem_t out_full_sem,out_free_sem,out_done_sem;
+static int out_started=0;
+static int out_inflight=0;
+static void ring_push(struct OutRing* r,int i){
+    unsigned int t=atomic_load_explicit(&r->tail,memory_order_relaxed);
+    r->slot[t%OUT_BUFFERS]=i;
+    atomic_store_explicit(&r->tail,t+1,memory_order_release);
+}
+static int ring_pop(struct OutRing* r){
+    unsigned int h=atomic_load_explicit(&r->head,memory_order_relaxed);
+    int i;
+    while(h==atomic_load_explicit(&r->tail,memory_order_acquire))
+        ;
+    i=r->slot[h%OUT_BUFFERS];
+    atomic_store_explicit(&r->head,h+1,memory_order_release);
+    return i;
+}
+static void sem_take(sem_t* s){
+    while(sem_wait(s)!=0 && errno==EINTR)
+        ;
+}
+static void write_all(const char* p,int n){
+    ssize_t w;
+    while(n>0){
+        w=write(1,p,n);
+        if(w<0 && errno==EINTR)
+            continue;
+        if(w<=0)
+            return;
+        p+=w;
+        n-=(int)w;
+    }
+}
+static void* out_writer(void* arg){
+    int i;
+    (void)arg;
+    for(;;){
+        sem_take(&out_full_sem);
+        i=ring_pop(&out_full);
+        write_all(out_pool[i],out_used[i]);
+        ring_push(&out_free,i);
+        sem_post(&out_free_sem);
+        sem_post(&out_done_sem);
+    }
+    return NULL;
+}
+static int out_start(){
+    pthread_t writer;
+    int i;
+    sem_init(&out_full_sem,0,0);
+    sem_init(&out_free_sem,0,OUT_BUFFERS-1);
+    sem_init(&out_done_sem,0,0);
+    for(i=1;i<OUT_BUFFERS;i++)
+        ring_push(&out_free,i);
+    if(pthread_create(&writer,NULL,out_writer,NULL)!=0)
+        return 0;
+    pthread_detach(writer);
+    out_started=1;
+    return 1;
+}
+//Waits until the writer thread has written every queued buffer.
+static void out_sync(){
+    for(;out_inflight>0;out_inflight--)
+        sem_take(&out_done_sem);
+}
+//Queues the current buffer and takes a free one, waiting if none is.
+static void out_handoff(){
+    fflush(stdout);
+    if(!out_started && !out_start()){
+        write_all(out_buf,out_len);
+        out_len=0;
+        return;
+    }
+    out_used[out_cur]=out_len;
+    ring_push(&out_full,out_cur);
+    out_inflight++;
+    sem_post(&out_full_sem);
+    if(sem_trywait(&out_free_sem)!=0){
+        LIST_PROBE1(output_stall,out_inflight);
+        sem_take(&out_free_sem);
+    }
+    out_cur=ring_pop(&out_free);
+    out_buf=out_pool[out_cur];
+    out_len=0;
+}
+static void out_spill(){
+    out_handoff();
+}
+static void out_flush(){
+    out_sync();
+    fwrite(out_buf,1,out_len,stdout);
+    fflush(stdout);
+    out_len=0;
+}
+//End of a full dump: returns once the text is queued, not written.
+static void out_dump_end(){
+    if(out_len>0)
+        out_handoff();
+}
+#else
+static char out_buf[OUT_SIZE];
+static void out_sync(){
+}
+static void out_flush(){
+    fwrite(out_buf,1,out_len,stdout);
+    fflush(stdout);
+    out_len=0;
+}
+static void out_spill(){
+    out_flush();
+}
+static void out_dump_end(){
+    out_flush();
+}
+#endif
+static void window_init(){
+    char* k=getenv("LIST_WINDOW");
+    if(k!=NULL){
+        window_k=atoi(k);
+        if(window_k<0)
+            window_k=0;
+        if(window_k>WINDOW_MAX)
+            window_k=WINDOW_MAX;
+    }
+}
+static void out_str(const char* s){
+    int n=(int)strlen(s);
+    if(out_len+n>OUT_SIZE)
+        out_spill();
+    memcpy(out_buf+out_len,s,n);
+    out_len+=n;
+}
+//Writes item and a tab.
+static void out_int(int item){
+    char tmp[12];
+    int n=0;
+    unsigned int v=item<0?0u-(unsigned int)item:(unsigned int)item;
+    if(out_len+13>OUT_SIZE)
+        out_spill();
+    do{
+        tmp[n++]=(char)('0'+v%10);
+        v/=10;
+    }while(v!=0);
+    if(item<0)
+        out_buf[out_len++]='-';
+    while(n>0)
+        out_buf[out_len++]=tmp[--n];
+    out_buf[out_len++]='\t';
+}
+//Window over a walk that can only go forwards: items past the first K
+//are kept in a ring, so the last K come out once the walk ends. CDLL.c
+//walks back from start->prev instead, so these are inline: unused, they
+//draw no warning.
+struct Window{
+    int seen;
+    int ring[WINDOW_MAX];
+};
+static inline void window_begin(struct Window* w){
+    w->seen=0;
+}
+static inline void window_item(struct Window* w,int item){
+    if(w->seen<window_k || window_k==0)
+        out_int(item);
+    else
+        w->ring[(w->seen-window_k)%window_k]=item;
+    w->seen++;
+}
+static void window_gap(int skipped){
+    char tmp[32];
+    if(skipped>0){
+        sprintf(tmp,"... %d more ...\t",skipped);
+        out_str(tmp);
+    }
+}
+//Length and checksum line; ends every window.
+static void window_footer(const struct ListStats* s){
+    char tmp[64];
+    sprintf(tmp,"\n(length=%d checksum=%016llx)\n",s->length,s->checksum);
+    out_str(tmp);
+    out_flush();
+}
+static inline void window_end(struct Window* w,const struct ListStats* s){
+    int tail,i,first;
+    if(window_k>0 && w->seen>window_k){
+        tail=w->seen-window_k;
+        if(tail>window_k)
+            tail=window_k;
+        window_gap(w->seen-window_k-tail);
+        first=w->seen-window_k-tail;
+        for(i=0;i<tail;i++)
+            out_int(w->ring[(first+i)%window_k]);
+    }
+    window_footer(s);
+}
+#endif
@@ -0,0 +1,162 @@
+// Read-only snapshot of a list after its build phase.
+//
+//   dsa::frozen_list<int> f = dsa::freeze(list);    // list is now empty
+//   f.search(42);                                   // searching_sll result
+//   f.traversal([](int v) { ... });                 // linear scan
+//   list = dsa::thaw(std::move(f));                 // back to linked form
+//
+// Payloads are moved into one contiguous array in list order. The optional
+// index is a sorted copy of the keys in Eytzinger (BFS) order: the search
+// descends with k = 2k + (key[k] < x), with no unpredictable branch, and
+// the cache line 4 levels down is prefetched while the current one is
+// compared.
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "list_engine.hpp"
+#include "list_traits.hpp"
+
+namespace dsa {
+
+template <class T>
+class frozen_list
+{
+public:
+	using value_type = T;
+
+	frozen_list() = default;
+	frozen_list(std::vector<T> items, bool with_index) : items_(std::move(items))
+	{
+		if (with_index)
+			build_index();
+	}
+
+	std::size_t length() const { return items_.size(); }
+	bool empty() const { return items_.empty(); }
+	bool indexed() const { return !keys_.empty() || items_.empty(); }
+	const T * data() const { return items_.data(); }
+	const T & operator[](std::size_t i) const { return items_[i]; }
+
+	// 1-based position of the first occurrence, or 0 when absent.
+	std::size_t search(const T & item) const
+	{
+		if (keys_.empty())
+		{
+			auto it = std::find(items_.begin(), items_.end(), item);
+			return it == items_.end() ? 0 : std::size_t(it - items_.begin()) + 1;
+		}
+		std::size_t n = items_.size(), k = 1;
+		while (k <= n)
+		{
+#if defined(__GNUC__)
+			__builtin_prefetch(keys_.data() + k * prefetch_stride);
+#endif
+			k = 2 * k + (keys_[k] < item);
+		}
+		// Undo the trailing right turns plus one left turn to land on the
+		// lower bound; k becomes 0 when every key is smaller.
+		k >>= ctz(~k) + 1;
+		if (k == 0 || keys_[k] != item)
+			return 0;
+		return std::size_t(pos_[k]) + 1;
+	}
+
+	template <class F>
+	void traversal(F && f) const
+	{
+		for (const T & v : items_)
+			f(v);
+	}
+
+	std::vector<T> release() && { keys_.clear(); pos_.clear(); return std::move(items_); }
+
+private:
+	// keys_[16k .. 16k+15] are k's descendants 4 levels down.
+	static constexpr std::size_t prefetch_stride = 16;
+
+	static unsigned ctz(std::size_t v)
+	{
+#if defined(__GNUC__)
+		return unsigned(__builtin_ctzll((unsigned long long)v));
+#else
+		unsigned c = 0;
+		while ((v & 1) == 0)
+		{
+			v >>= 1;
+			c++;
+		}
+		return c;
+#endif
+	}
+
+	void build_index()
+	{
+		std::size_t n = items_.size();
+		std::vector<std::uint32_t> order(n);
+		std::iota(order.begin(), order.end(), 0u);
+		// Stable, so equal keys keep list order and the lower bound is the
+		// first occurrence.
+		std::stable_sort(order.begin(), order.end(),
+			[this](std::uint32_t a, std::uint32_t b) { return items_[a] < items_[b]; });
+		keys_.resize(n + 1);
+		pos_.resize(n + 1);
+		std::size_t i = 0;
+		fill(order, i, 1);
+	}
+
+	void fill(const std::vector<std::uint32_t> & order, std::size_t & i, std::size_t k)
+	{
+		if (k > items_.size())
+			return;
+		fill(order, i, 2 * k);
+		keys_[k] = items_[order[i]];
+		pos_[k] = order[i];
+		i++;
+		fill(order, i, 2 * k + 1);
+	}
+
+	std::vector<T> items_;
+	std::vector<T> keys_;             // 1-based Eytzinger layout
+	std::vector<std::uint32_t> pos_;  // list position of keys_[k]
+};
+
+// Moves every payload out of the list, leaving it empty.
+template <class T>
+frozen_list<T> freeze(sll<T> & list, bool with_index = true)
+{
+	std::vector<T> items;
+	items.reserve(list.length());
+	for (auto * ptr = list.head(); ptr != nullptr; ptr = ptr->link)
+		items.push_back(std::move(ptr->info));
+	list.clear();
+	return frozen_list<T>(std::move(items), with_index);
+}
+
+// Copies any NULL-terminated chain (e.g. a struct node * from menu_linked.c)
+// without touching it.
+template <class N>
+frozen_list<value_type_of<N>> freeze_chain(N * start, bool with_index = true)
+{
+	std::vector<value_type_of<N>> items;
+	walk_nodes<walk::linear>(start, [&items](N * p) {
+		items.push_back(value_of(p));
+		return true;
+	});
+	return frozen_list<value_type_of<N>>(std::move(items), with_index);
+}
+
+template <class T>
+sll<T> thaw(frozen_list<T> && frozen, std::pmr::memory_resource * mr = std::pmr::get_default_resource())
+{
+	sll<T> list(mr);
+	for (T & v : std::move(frozen).release())
+		list.insert_end(std::move(v));
+	return list;
+}
+
+} // namespace dsa
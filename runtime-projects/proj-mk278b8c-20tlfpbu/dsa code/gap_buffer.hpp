@@ -0,0 +1,196 @@
+// Gap buffer for runs of edits at or near one position (insert_LOC in
+// menu_DLL.c, insertAtIndex in linked_insert.c).
+//
+// Items sit in one array with a hole (the gap) at the cursor:
+//
+//   [ a b c | _ _ _ _ | d e ]
+//           gap_beg   gap_end
+//
+// Inserting or deleting at the cursor only moves a gap edge. Moving the
+// cursor memmoves the items between the old and new position across the
+// gap, so a run of nearby edits costs O(distance) instead of a list walk
+// and a malloc per node. The array comes from a pmr resource, like the
+// blocks of unrolled_list and soa_list.
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include "list_traits.hpp"
+
+namespace dsa {
+
+template <class T>
+class gap_buffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "gap_buffer moves items with memmove");
+
+public:
+	using value_type = T;
+
+	explicit gap_buffer(std::size_t capacity = 64, std::pmr::memory_resource * mr = std::pmr::get_default_resource())
+		: mr_(mr)
+	{
+		if (capacity == 0)
+			capacity = 1;
+		buf_ = static_cast<T *>(mr_->allocate(capacity * sizeof(T), alignof(T)));
+		cap_ = gap_end_ = capacity;
+	}
+	~gap_buffer()
+	{
+		if (buf_)
+			mr_->deallocate(buf_, cap_ * sizeof(T), alignof(T));
+	}
+
+	// The source is left empty with no array; its next insert allocates one.
+	gap_buffer(gap_buffer && o) noexcept
+		: mr_(o.mr_), buf_(o.buf_), cap_(o.cap_), gap_beg_(o.gap_beg_), gap_end_(o.gap_end_)
+	{
+		o.buf_ = nullptr;
+		o.cap_ = o.gap_beg_ = o.gap_end_ = 0;
+	}
+	gap_buffer(const gap_buffer &) = delete;
+	gap_buffer & operator=(const gap_buffer &) = delete;
+
+	std::size_t length() const { return cap_ - (gap_end_ - gap_beg_); }
+	bool empty() const { return length() == 0; }
+	std::size_t capacity() const { return cap_; }
+	std::size_t cursor() const { return gap_beg_; }
+	std::pmr::memory_resource * resource() const { return mr_; }
+
+	const T & operator[](std::size_t i) const { return i < gap_beg_ ? buf_[i] : buf_[i + (gap_end_ - gap_beg_)]; }
+
+	// Moves the cursor so the next insert lands at 0-based index pos.
+	void move_cursor(std::size_t pos)
+	{
+		if (pos > length())
+			pos = length();
+		if (pos < gap_beg_)
+		{
+			std::size_t n = gap_beg_ - pos;
+			std::memmove(buf_ + gap_end_ - n, buf_ + pos, n * sizeof(T));
+			gap_beg_ -= n;
+			gap_end_ -= n;
+		}
+		else if (pos > gap_beg_)
+		{
+			std::size_t n = pos - gap_beg_;
+			std::memmove(buf_ + gap_beg_, buf_ + gap_end_, n * sizeof(T));
+			gap_beg_ += n;
+			gap_end_ += n;
+		}
+	}
+
+	// Inserts before the cursor; the cursor ends up after the new item, so
+	// repeated inserts type forwards.
+	list_status insert(const T & item)
+	{
+		if (gap_beg_ == gap_end_ && !grow())
+			return list_status::overflow;
+		buf_[gap_beg_++] = item;
+		return list_status::ok;
+	}
+
+	// Removes the item before the cursor (backspace).
+	list_status erase_before(T * out = nullptr)
+	{
+		if (gap_beg_ == 0)
+			return list_status::underflow;
+		--gap_beg_;
+		if (out)
+			*out = buf_[gap_beg_];
+		return list_status::ok;
+	}
+
+	// Removes the item after the cursor (delete key).
+	list_status erase_after(T * out = nullptr)
+	{
+		if (gap_end_ == cap_)
+			return list_status::underflow;
+		if (out)
+			*out = buf_[gap_end_];
+		++gap_end_;
+		return list_status::ok;
+	}
+
+	// Positional forms matching the C programs.
+	list_status insert_at(std::size_t index, const T & item) // insertAtIndex
+	{
+		if (index > length())
+			return list_status::not_found;
+		move_cursor(index);
+		return insert(item);
+	}
+
+	list_status insert_loc(const T & item, std::size_t loc) // insert_LOC, 1-based
+	{
+		if (loc == 0)
+			return list_status::not_found;
+		return insert_at(loc - 1, item);
+	}
+
+	list_status insert_beg(const T & item) { return insert_at(0, item); }
+	list_status insert_end(const T & item) { return insert_at(length(), item); }
+
+	list_status delete_at(std::size_t index, T * out = nullptr)
+	{
+		if (index >= length())
+			return list_status::underflow;
+		move_cursor(index);
+		return erase_after(out);
+	}
+
+	list_status delete_beg(T * out = nullptr) { return delete_at(0, out); }
+	list_status delete_end(T * out = nullptr) { return empty() ? list_status::underflow : delete_at(length() - 1, out); }
+
+	template <class F>
+	void traverse(F && f) const
+	{
+		for (std::size_t i = 0; i < gap_beg_; i++)
+			f(buf_[i]);
+		for (std::size_t i = gap_end_; i < cap_; i++)
+			f(buf_[i]);
+	}
+
+	void clear()
+	{
+		gap_beg_ = 0;
+		gap_end_ = cap_;
+	}
+
+private:
+	bool grow()
+	{
+		std::size_t ncap = cap_ ? cap_ * 2 : 1;
+		T * nbuf;
+		try
+		{
+			nbuf = static_cast<T *>(mr_->allocate(ncap * sizeof(T), alignof(T)));
+		}
+		catch (const std::bad_alloc &)
+		{
+			return false;
+		}
+		// The tail goes to the end so the gap widens at the cursor.
+		std::size_t tail = cap_ - gap_end_;
+		if (buf_)
+		{
+			std::memcpy(nbuf, buf_, gap_beg_ * sizeof(T));
+			std::memcpy(nbuf + ncap - tail, buf_ + gap_end_, tail * sizeof(T));
+			mr_->deallocate(buf_, cap_ * sizeof(T), alignof(T));
+		}
+		buf_ = nbuf;
+		gap_end_ = ncap - tail;
+		cap_ = ncap;
+		return true;
+	}
+
+	std::pmr::memory_resource * mr_;
+	T * buf_ = nullptr;
+	std::size_t cap_ = 0;
+	std::size_t gap_beg_ = 0;
+	std::size_t gap_end_ = 0;
+};
+
+} // namespace dsa
@@ -0,0 +1,218 @@
+// Doubly linked list addressed by generational handles instead of
+// struct Node pointers.
+//
+// Nodes live densely in one array and link to each other by slot index.
+// Callers hold a handle {index, generation} into a separate table that
+// maps to the node's current slot. Deleting a node bumps its table
+// entry's generation, so an old handle resolves to nullptr instead of to
+// whatever reuses the slot. Since outside code never holds a slot, nodes
+// can be moved: erase() fills the hole with the last node and compact()
+// re-lays nodes in list order for sequential walks. Handles stay valid.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "list_traits.hpp"
+
+namespace dsa {
+
+struct handle
+{
+	std::uint32_t index = UINT32_MAX;
+	std::uint32_t generation = 0;
+
+	bool null() const { return index == UINT32_MAX; }
+	friend bool operator==(handle a, handle b) { return a.index == b.index && a.generation == b.generation; }
+	friend bool operator!=(handle a, handle b) { return !(a == b); }
+};
+
+template <class T>
+class handle_list
+{
+	static constexpr std::uint32_t nil = UINT32_MAX;
+
+	struct node
+	{
+		T info;
+		std::uint32_t prev;
+		std::uint32_t next;
+		std::uint32_t owner; // table entry pointing at this slot
+	};
+
+	struct entry
+	{
+		std::uint32_t slot;       // node slot while live, next free entry otherwise
+		std::uint32_t generation; // odd while live, even while free
+	};
+
+public:
+	using value_type = T;
+
+	std::size_t length() const { return nodes_.size(); }
+	bool empty() const { return nodes_.empty(); }
+
+	handle insert_beg(T item) { return link(nil, std::move(item)); }
+	handle insert_end(T item) { return link(tail_, std::move(item)); }
+
+	// Inserts after the node `at` refers to; a stale `at` inserts nothing.
+	handle insert_after(handle at, T item)
+	{
+		std::uint32_t s = slot_of(at);
+		if (s == nil)
+			return handle();
+		return link(s, std::move(item));
+	}
+
+	bool valid(handle h) const { return slot_of(h) != nil; }
+
+	T * resolve(handle h)
+	{
+		std::uint32_t s = slot_of(h);
+		return s == nil ? nullptr : &nodes_[s].info;
+	}
+
+	const T * resolve(handle h) const
+	{
+		std::uint32_t s = slot_of(h);
+		return s == nil ? nullptr : &nodes_[s].info;
+	}
+
+	handle head() const { return head_ == nil ? handle() : handle_at(head_); }
+	handle tail() const { return tail_ == nil ? handle() : handle_at(tail_); }
+	handle next(handle h) const
+	{
+		std::uint32_t s = slot_of(h);
+		return s == nil || nodes_[s].next == nil ? handle() : handle_at(nodes_[s].next);
+	}
+	handle prev(handle h) const
+	{
+		std::uint32_t s = slot_of(h);
+		return s == nil || nodes_[s].prev == nil ? handle() : handle_at(nodes_[s].prev);
+	}
+
+	// O(1): unlinks the node, retires its handle and moves the last node in
+	// the array into the hole.
+	list_status erase(handle h, T * out = nullptr)
+	{
+		std::uint32_t s = slot_of(h);
+		if (s == nil)
+			return list_status::not_found;
+		node & n = nodes_[s];
+		if (out)
+			*out = std::move(n.info);
+		(n.prev == nil ? head_ : nodes_[n.prev].next) = n.next;
+		(n.next == nil ? tail_ : nodes_[n.next].prev) = n.prev;
+		entry & e = table_[h.index];
+		e.generation++;
+		e.slot = free_;
+		free_ = h.index;
+		std::uint32_t last = std::uint32_t(nodes_.size() - 1);
+		if (s != last)
+			relocate(last, s);
+		nodes_.pop_back();
+		return list_status::ok;
+	}
+
+	list_status delete_beg(T * out = nullptr) { return head_ == nil ? list_status::underflow : erase(handle_at(head_), out); }
+	list_status delete_end(T * out = nullptr) { return tail_ == nil ? list_status::underflow : erase(handle_at(tail_), out); }
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (std::uint32_t s = head_; s != nil; s = nodes_[s].next)
+			f(nodes_[s].info);
+	}
+
+	// Re-lays nodes in list order so a walk is a linear scan.
+	void compact()
+	{
+		std::vector<node> laid;
+		laid.reserve(nodes_.size());
+		for (std::uint32_t s = head_; s != nil; s = nodes_[s].next)
+		{
+			std::uint32_t i = std::uint32_t(laid.size());
+			laid.push_back(std::move(nodes_[s]));
+			node & n = laid.back();
+			n.prev = i == 0 ? nil : i - 1;
+			n.next = i + 1;
+			table_[n.owner].slot = i;
+		}
+		if (!laid.empty())
+			laid.back().next = nil;
+		nodes_.swap(laid);
+		head_ = nodes_.empty() ? nil : 0;
+		tail_ = nodes_.empty() ? nil : std::uint32_t(nodes_.size() - 1);
+	}
+
+	void clear()
+	{
+		for (const node & n : nodes_)
+		{
+			entry & e = table_[n.owner];
+			e.generation++;
+			e.slot = free_;
+			free_ = n.owner;
+		}
+		nodes_.clear();
+		head_ = tail_ = nil;
+	}
+
+private:
+	std::uint32_t slot_of(handle h) const
+	{
+		if (h.index >= table_.size())
+			return nil;
+		const entry & e = table_[h.index];
+		return e.generation == h.generation && (e.generation & 1) ? e.slot : nil;
+	}
+
+	handle handle_at(std::uint32_t s) const
+	{
+		std::uint32_t owner = nodes_[s].owner;
+		return handle{owner, table_[owner].generation};
+	}
+
+	handle link(std::uint32_t prev, T item)
+	{
+		std::uint32_t idx;
+		if (free_ != nil)
+		{
+			idx = free_;
+			free_ = table_[idx].slot;
+		}
+		else
+		{
+			idx = std::uint32_t(table_.size());
+			table_.push_back(entry{nil, 0});
+		}
+		std::uint32_t s = std::uint32_t(nodes_.size());
+		std::uint32_t next = prev == nil ? head_ : nodes_[prev].next;
+		nodes_.push_back(node{std::move(item), prev, next, idx});
+		(prev == nil ? head_ : nodes_[prev].next) = s;
+		(next == nil ? tail_ : nodes_[next].prev) = s;
+		entry & e = table_[idx];
+		e.slot = s;
+		e.generation++;
+		return handle{idx, e.generation};
+	}
+
+	// Moves the node in slot `from` to slot `to`, patching its neighbours
+	// and its table entry.
+	void relocate(std::uint32_t from, std::uint32_t to)
+	{
+		node & n = nodes_[to];
+		n = std::move(nodes_[from]);
+		(n.prev == nil ? head_ : nodes_[n.prev].next) = to;
+		(n.next == nil ? tail_ : nodes_[n.next].prev) = to;
+		table_[n.owner].slot = to;
+	}
+
+	std::vector<node> nodes_;
+	std::vector<entry> table_;
+	std::uint32_t free_ = nil;
+	std::uint32_t head_ = nil;
+	std::uint32_t tail_ = nil;
+};
+
+} // namespace dsa
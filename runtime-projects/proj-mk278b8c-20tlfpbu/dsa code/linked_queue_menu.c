@@ -1,12 +1,23 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"retire.h"
+#include"list_stats.h"
+#include"display.h"
+#include"list_probes.h"
 struct Node{
     int info;
     struct Node* link;
 };
-void enqueue(struct Node** front, struct Node** rear){
+//A queue is its two end pointers plus the running stats of its items.
+struct Queue{
+    struct Node* front;
+    struct Node* rear;
+    struct ListStats stats;
+};
+void enqueue(struct Queue* q){
     struct Node* new;
-    int item;
+    int item=0;
+    LIST_PROBE3(enqueue_entry,&q->stats,q->stats.length,0);
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
         printf("OVERFLOW");
@@ -16,60 +27,94 @@ void enqueue(struct Node** front, struct Node** rear){
        scanf("%d",&item);
        new->info = item;
        new->link = NULL;
-       if(*front==NULL && *rear==NULL){
-        *front=*rear=new;
+       stats_add(&q->stats,item);
+       if(q->front==NULL && q->rear==NULL){
+        q->front=q->rear=new;
        }
        else{
-        (*rear)->link=new;
-        *rear=new;
+        q->rear->link=new;
+        q->rear=new;
        }
     }
+    LIST_PROBE3(enqueue_return,&q->stats,q->stats.length,item);
 }
-void dequeue(struct Node** front,struct Node**rear){
+void dequeue(struct Queue* q){
     struct Node*ptr;
-    if(*front==NULL && *rear==NULL){
+    int item=0;
+    LIST_PROBE3(dequeue_entry,&q->stats,q->stats.length,0);
+    if(q->front==NULL && q->rear==NULL){
         printf("UNDERFLOW");
     }
     else{
-        ptr=*front; 
-        if(*front==*rear){
-            *front=*rear=NULL;
+        ptr=q->front;
+        item=ptr->info;
+        stats_remove(&q->stats,item);
+        if(q->front==q->rear){
+            q->front=q->rear=NULL;
         }
         else{
-            *front=(*front)->link;
-            free(ptr);
+            q->front=q->front->link;
         }
+        retire(ptr);
     }
-    
+    LIST_PROBE3(dequeue_return,&q->stats,q->stats.length,item);
 }
-void traverse(struct Node* front){
-    struct Node* ptr=front;
+void traverse(struct Queue* q){
+    struct Node* ptr=q->front;
     printf("elements in the queue are:");
     while(ptr!=NULL){
-        printf("%d\t",ptr->info);
+        out_int(ptr->info);
         ptr=ptr->link;
     }
-    printf("\n");  
+    out_str("\n");
+    out_dump_end();
+}
+//Front and rear K items, length and checksum; shown after each op.
+void display(struct Queue* q){
+    struct Node* ptr;
+    struct Window w;
+    printf("elements in the queue are:");
+    window_begin(&w);
+    for(ptr=q->front;ptr!=NULL;ptr=ptr->link)
+        window_item(&w,ptr->info);
+    window_end(&w,&q->stats);
+}
+//O(1) unless a dequeue took the min or max; then one rescan.
+void show_stats(struct Queue* q){
+    struct Node* ptr;
+    if(q->stats.extremes_stale){
+        stats_rescan_begin(&q->stats);
+        for(ptr=q->front;ptr!=NULL;ptr=ptr->link)
+            stats_rescan(&q->stats,ptr->info);
+    }
+    stats_print(&q->stats);
 }
 int main(){
-    struct Node* front=NULL,*rear=NULL;
-    int item,option;
+    struct Queue q;
+    int option;
+    q.front=q.rear=NULL;
+    stats_reset(&q.stats);
+    window_init();
     do{
-        printf("\nMENU\n1->enqueue\n2->dequeue\n3->traverse\n4->exit\nenter your choice");
+        retire_flush();
+        out_sync();
+        printf("\nMENU\n1->enqueue\n2->dequeue\n3->traverse\n4->stats\n5->exit\nenter your choice");
         scanf("%d",&option);
         switch(option){
-            case 1: enqueue(&front,&rear);
-                   traverse(front);
+            case 1: enqueue(&q);
+                   display(&q);
+                   break;
+            case 2: dequeue(&q);
+                   display(&q);
                    break;
-            case 2: dequeue(&front,&rear);
-                   traverse(front);
+            case 3: traverse(&q);
                    break;
-            case 3: traverse(front);
+            case 4: show_stats(&q);
                    break;
-            case 4: exit(0);
+            case 5: exit(0);
             default:printf("invalid option");
 
         }
-    } while(option<5);
+    } while(option<6);
 
 }
\ No newline at end of file
@@ -1,13 +1,23 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"retire.h"
+#include"list_stats.h"
+#include"display.h"
+#include"list_probes.h"
 struct Node{
     int info;
     struct Node* link;
 
 };
-struct Node* push(struct Node* top){
-    struct Node* new;
-    int item;
+//A stack is its top pointer plus the running stats of its items.
+struct Stack{
+    struct Node* top;
+    struct ListStats stats;
+};
+void push(struct Stack* s){
+    struct Node* new,*top=s->top;
+    int item=0;
+    LIST_PROBE3(push_entry,&s->stats,s->stats.length,0);
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
         printf("OVERFLOW");
@@ -17,6 +27,7 @@ struct Node* push(struct Node* top){
         scanf("%d",&item);
         new->info=item;
         new->link=NULL;
+        stats_add(&s->stats,item);
         if(top==NULL){
             top=new;
         }
@@ -25,23 +36,29 @@ struct Node* push(struct Node* top){
             top=new;
         }
     }
-    return top;
+    s->top=top;
+    LIST_PROBE3(push_return,&s->stats,s->stats.length,item);
 }
-struct Node* pop(struct Node* top){
-    struct Node* ptr;
+void pop(struct Stack* s){
+    struct Node* top=s->top,*ptr;
+    int item=0;
+    LIST_PROBE3(pop_entry,&s->stats,s->stats.length,0);
     if(top==NULL){
         printf("UNDERFLOW");
     }
     else{
         ptr=top;
-        printf("deleted item is:%d\n",ptr->info);
+        item=ptr->info;
+        printf("deleted item is:%d\n",item);
+        stats_remove(&s->stats,item);
         top=ptr->link;
-        free(ptr);
+        retire(ptr);
     }
-    return top;
+    s->top=top;
+    LIST_PROBE3(pop_return,&s->stats,s->stats.length,item);
 }
-void peep(struct Node* top){
-    struct Node* ptr;
+void peep(struct Stack* s){
+    struct Node* top=s->top,*ptr;
     if(top==NULL){
         printf("stack is empty");
     }
@@ -49,29 +66,61 @@ void peep(struct Node* top){
         ptr=top;
         printf("list of the stack are:");
         while(ptr!=NULL){
-            printf("%d\t",ptr->info);
+            out_int(ptr->info);
             ptr=ptr->link;
         }
-        printf("\n");
+        out_str("\n");
+        out_dump_end();
     }
 }
+//Top and bottom K items, length and checksum; shown after each op.
+void display(struct Stack* s){
+    struct Node* top=s->top,*ptr;
+    struct Window w;
+    if(top==NULL){
+        printf("stack is empty");
+        return;
+    }
+    printf("list of the stack are:");
+    window_begin(&w);
+    for(ptr=top;ptr!=NULL;ptr=ptr->link)
+        window_item(&w,ptr->info);
+    window_end(&w,&s->stats);
+}
+//O(1) unless a pop took the min or max; then one rescan.
+void show_stats(struct Stack* s){
+    struct Node* ptr;
+    if(s->stats.extremes_stale){
+        stats_rescan_begin(&s->stats);
+        for(ptr=s->top;ptr!=NULL;ptr=ptr->link)
+            stats_rescan(&s->stats,ptr->info);
+    }
+    stats_print(&s->stats);
+}
 int main(){
-    struct Node* top=NULL;
-    int item,choice;
+    struct Stack s;
+    int choice;
+    s.top=NULL;
+    stats_reset(&s.stats);
+    window_init();
     do{
-        printf("\nPRESS\n1->PUSH\n2->POP\n3->PEEP\nenter your option");
+        retire_flush();
+        out_sync();
+        printf("\nPRESS\n1->PUSH\n2->POP\n3->PEEP\n4->STATS\n5->EXIT\nenter your option");
         scanf("%d",&choice);
         switch(choice){
-            case 1: top=push(top);
-                    peep(top);break;
-            case 2: top=pop(top);
-                    peep(top);
+            case 1: push(&s);
+                    display(&s);break;
+            case 2: pop(&s);
+                    display(&s);
+                    break;
+            case 3: peep(&s);
                     break;
-            case 3: peep(top);
+            case 4: show_stats(&s);
                     break;
-            case 4: exit(0);
+            case 5: exit(0);
             default: printf("invalid choice");
         }
-    }while(choice<5);
+    }while(choice<6);
 
 }
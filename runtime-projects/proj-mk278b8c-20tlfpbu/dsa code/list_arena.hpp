@@ -0,0 +1,340 @@
+// Shared arena for many small request-scoped lists.
+//
+//   dsa::list_arena arena;                        // long-lived, shared
+//   dsa::arena_scope req(arena);                  // one per request
+//   dsa::arena_region * r = req.make_region();    // one per list
+//   dsa::sll<int> list(r);
+//   ...
+//   list.abandon();
+//   r->release();      // O(1): the list's blocks go back to the arena
+//   req.release();     // O(1): every region still open in the request
+//
+// A region bump-allocates from a private chain of 64 KiB blocks and keeps
+// small per-size free lists so nodes deleted mid-request are reused.
+// Releasing a region splices its whole chain onto the arena's free blocks
+// without looking at a single node. Releasing a scope splices the scope's
+// region list onto the arena's pending list in O(1); pending chains are
+// recycled later, one region at a time, when the arena runs out of free
+// blocks.
+//
+// Lists must abandon() their nodes before their region goes away. Not
+// thread-safe: use one arena per thread.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+namespace dsa {
+
+class list_arena;
+class arena_scope;
+
+namespace arena_detail {
+
+struct block
+{
+	block * next;
+	std::size_t size; // bytes including this header
+};
+
+} // namespace arena_detail
+
+struct arena_stats
+{
+	std::size_t blocks_mapped = 0;   // standard blocks taken from upstream
+	std::size_t blocks_free = 0;     // standard blocks ready for reuse
+	std::size_t regions_open = 0;
+	std::size_t regions_pending = 0; // released with a scope, not yet recycled
+	std::size_t region_releases = 0;
+	std::size_t scope_releases = 0;
+};
+
+class arena_region : public std::pmr::memory_resource
+{
+public:
+	// Hands every block of this region back to the arena. The region
+	// object lives in its own first block, so it is gone afterwards.
+	void release();
+
+	std::size_t bytes_used() const { return used_; }
+
+protected:
+	void * do_allocate(std::size_t bytes, std::size_t align) override;
+	void do_deallocate(void * p, std::size_t bytes, std::size_t align) override;
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+
+private:
+	friend class list_arena;
+	friend class arena_scope;
+
+	// Recycled node slots for 16, 32, 48 and 64 byte requests.
+	static constexpr std::size_t classes = 4;
+	static constexpr std::size_t quantum = 16;
+
+	arena_region(list_arena & arena, arena_scope * scope, arena_detail::block * first, char * cur, char * end)
+		: arena_(arena), scope_(scope), first_(first), last_(first), cur_(cur), end_(end)
+	{
+	}
+
+	void * carve(std::size_t bytes, std::size_t align);
+
+	list_arena & arena_;
+	arena_scope * scope_;
+	arena_region * prev_ = nullptr; // siblings in the scope
+	arena_region * next_ = nullptr;
+	arena_detail::block * first_;   // chain of this region's blocks
+	arena_detail::block * last_;
+	char * cur_;
+	char * end_;
+	std::size_t used_ = 0;
+	std::size_t blocks_ = 1;        // standard-size blocks in the chain
+	void * free_[classes] = {};
+};
+
+class list_arena
+{
+public:
+	static constexpr std::size_t block_size = std::size_t(64) * 1024;
+
+	explicit list_arena(std::pmr::memory_resource * upstream = std::pmr::new_delete_resource()) : upstream_(upstream) {}
+
+	~list_arena()
+	{
+		while (pending_)
+			recycle_pending();
+		while (free_)
+		{
+			arena_detail::block * b = free_;
+			free_ = b->next;
+			upstream_->deallocate(b, b->size, alignof(std::max_align_t));
+		}
+	}
+
+	list_arena(const list_arena &) = delete;
+	list_arena & operator=(const list_arena &) = delete;
+
+	// A region outside any scope; release it yourself.
+	arena_region * make_region() { return make_region(nullptr); }
+
+	const arena_stats & stats() const { return stats_; }
+
+	// Returns cached free blocks to upstream.
+	void shrink()
+	{
+		while (pending_)
+			recycle_pending();
+		while (free_)
+		{
+			arena_detail::block * b = free_;
+			free_ = b->next;
+			if (b->size == block_size)
+				stats_.blocks_free--;
+			upstream_->deallocate(b, b->size, alignof(std::max_align_t));
+		}
+	}
+
+private:
+	friend class arena_region;
+	friend class arena_scope;
+
+	arena_region * make_region(arena_scope * scope)
+	{
+		arena_detail::block * b = take_block(block_size);
+		char * base = reinterpret_cast<char *>(b) + header_size();
+		arena_region * r = ::new (base) arena_region(*this, scope, b, base + sizeof(arena_region),
+			reinterpret_cast<char *>(b) + block_size);
+		stats_.regions_open++;
+		return r;
+	}
+
+	static constexpr std::size_t header_size()
+	{
+		return (sizeof(arena_detail::block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+	}
+
+	arena_detail::block * take_block(std::size_t size)
+	{
+		if (size == block_size)
+		{
+			for (;;)
+			{
+				while (free_)
+				{
+					arena_detail::block * b = free_;
+					free_ = b->next;
+					if (b->size == block_size)
+					{
+						stats_.blocks_free--;
+						b->next = nullptr;
+						return b;
+					}
+					// Oversized blocks ride along in spliced chains; drop them here.
+					upstream_->deallocate(b, b->size, alignof(std::max_align_t));
+				}
+				if (pending_ == nullptr)
+					break;
+				recycle_pending();
+			}
+			stats_.blocks_mapped++;
+		}
+		void * p = upstream_->allocate(size, alignof(std::max_align_t));
+		arena_detail::block * b = static_cast<arena_detail::block *>(p);
+		b->next = nullptr;
+		b->size = size;
+		return b;
+	}
+
+	// O(1): the whole chain of a region goes onto the free list.
+	void give_chain(arena_detail::block * first, arena_detail::block * last, std::size_t standard_blocks)
+	{
+		last->next = free_;
+		free_ = first;
+		stats_.blocks_free += standard_blocks;
+	}
+
+	void recycle_pending();
+
+	std::pmr::memory_resource * upstream_;
+	arena_detail::block * free_ = nullptr;
+	arena_region * pending_ = nullptr; // regions of released scopes
+	arena_stats stats_;
+};
+
+// All regions made through a scope can be dropped together in O(1).
+class arena_scope
+{
+public:
+	explicit arena_scope(list_arena & arena) : arena_(arena) {}
+	~arena_scope() { release(); }
+
+	arena_scope(const arena_scope &) = delete;
+	arena_scope & operator=(const arena_scope &) = delete;
+
+	arena_region * make_region()
+	{
+		arena_region * r = arena_.make_region(this);
+		r->next_ = head_;
+		if (head_)
+			head_->prev_ = r;
+		else
+			tail_ = r;
+		head_ = r;
+		count_++;
+		return r;
+	}
+
+	std::size_t regions() const { return count_; }
+
+	// Queues every open region of the scope for recycling; region objects
+	// from this scope are invalid afterwards.
+	void release()
+	{
+		if (head_ == nullptr)
+			return;
+		tail_->next_ = arena_.pending_;
+		if (arena_.pending_)
+			arena_.pending_->prev_ = tail_;
+		arena_.pending_ = head_;
+		arena_.stats_.regions_open -= count_;
+		arena_.stats_.regions_pending += count_;
+		arena_.stats_.scope_releases++;
+		head_ = tail_ = nullptr;
+		count_ = 0;
+	}
+
+private:
+	friend class arena_region;
+
+	void unlink(arena_region * r)
+	{
+		(r->prev_ ? r->prev_->next_ : head_) = r->next_;
+		(r->next_ ? r->next_->prev_ : tail_) = r->prev_;
+		count_--;
+	}
+
+	list_arena & arena_;
+	arena_region * head_ = nullptr;
+	arena_region * tail_ = nullptr;
+	std::size_t count_ = 0;
+};
+
+inline void * arena_region::carve(std::size_t bytes, std::size_t align)
+{
+	std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(cur_) + align - 1) & ~(std::uintptr_t(align) - 1);
+	if (p + bytes <= reinterpret_cast<std::uintptr_t>(end_))
+	{
+		cur_ = reinterpret_cast<char *>(p + bytes);
+		return reinterpret_cast<void *>(p);
+	}
+	std::size_t hdr = list_arena::header_size();
+	std::size_t need = hdr + bytes + align;
+	std::size_t size = need <= list_arena::block_size ? list_arena::block_size : need;
+	arena_detail::block * b = arena_.take_block(size);
+	last_->next = b;
+	last_ = b;
+	char * base = reinterpret_cast<char *>(b) + hdr;
+	p = (reinterpret_cast<std::uintptr_t>(base) + align - 1) & ~(std::uintptr_t(align) - 1);
+	if (size == list_arena::block_size)
+	{
+		blocks_++;
+		cur_ = reinterpret_cast<char *>(p + bytes);
+		end_ = reinterpret_cast<char *>(b) + size;
+	}
+	return reinterpret_cast<void *>(p);
+}
+
+inline void * arena_region::do_allocate(std::size_t bytes, std::size_t align)
+{
+	used_ += bytes;
+	std::size_t c = (bytes + quantum - 1) / quantum;
+	if (c >= 1 && c <= classes && align <= quantum && free_[c - 1])
+	{
+		void * p = free_[c - 1];
+		free_[c - 1] = *static_cast<void **>(p);
+		return p;
+	}
+	if (c >= 1 && c <= classes && align <= quantum)
+		return carve(c * quantum, quantum);
+	return carve(bytes, align);
+}
+
+inline void arena_region::do_deallocate(void * p, std::size_t bytes, std::size_t align)
+{
+	used_ -= bytes;
+	std::size_t c = (bytes + quantum - 1) / quantum;
+	if (c >= 1 && c <= classes && align <= quantum)
+	{
+		*static_cast<void **>(p) = free_[c - 1];
+		free_[c - 1] = p;
+	}
+	// Anything bigger stays in the region until release().
+}
+
+inline void arena_region::release()
+{
+	list_arena & arena = arena_;
+	if (scope_)
+		scope_->unlink(this);
+	std::size_t standard = blocks_;
+	arena_detail::block * first = first_, *last = last_;
+	this->~arena_region();
+	arena.give_chain(first, last, standard);
+	arena.stats_.regions_open--;
+	arena.stats_.region_releases++;
+}
+
+inline void list_arena::recycle_pending()
+{
+	arena_region * r = pending_;
+	pending_ = r->next_;
+	if (pending_)
+		pending_->prev_ = nullptr;
+	std::size_t standard = r->blocks_;
+	arena_detail::block * first = r->first_, *last = r->last_;
+	r->~arena_region();
+	give_chain(first, last, standard);
+	stats_.regions_pending--;
+}
+
+} // namespace dsa
@@ -0,0 +1,637 @@
+// Owning C++ list engine: SLL, DLL, stack and queue with the op names of the
+// C programs, allocating nodes from a caller-supplied std::pmr resource.
+//
+//   std::pmr::monotonic_buffer_resource arena;   // per request
+//   dsa::sll<int> list(&arena);
+//   ...
+//   list.abandon();   // drop every node; the arena frees them in one go
+//
+// Nodes are dsa::sll_node / dsa::dll_node, so head() can be fed straight to
+// from_list() and the parallel kernels. Built with DSA_TRACE, the ops and
+// the phases of sort() show up in list_trace.hpp timelines. The named ops
+// (insert_beg ... search, push/pop, enqueue/dequeue) also carry the USDT
+// probes of list_probes.h, with the list object's address as list id and
+// the list_status, or the search location, as result.
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "list_probes.h"
+#include "list_trace.hpp"
+#include "list_traits.hpp"
+
+namespace dsa {
+
+namespace engine_detail {
+
+template <class Node, class... A>
+Node * make_node(std::pmr::memory_resource * mr, A &&... a)
+{
+	void * p;
+	try
+	{
+		p = mr->allocate(sizeof(Node), alignof(Node));
+	}
+	catch (const std::bad_alloc &)
+	{
+		return nullptr;
+	}
+	Node * n = static_cast<Node *>(p);
+	try
+	{
+		::new (static_cast<void *>(&n->info)) decltype(n->info)(std::forward<A>(a)...);
+	}
+	catch (...)
+	{
+		mr->deallocate(p, sizeof(Node), alignof(Node));
+		throw;
+	}
+	return n;
+}
+
+template <class Node>
+void drop_node(std::pmr::memory_resource * mr, Node * n)
+{
+	using T = decltype(n->info);
+	n->info.~T();
+	mr->deallocate(n, sizeof(Node), alignof(Node));
+}
+
+// Stable merge sort on `link`/`next` chains; O(n log n), no allocation.
+template <class N, class Less>
+N * merge_sort(N * start, std::size_t len, Less & less)
+{
+	if (len < 2)
+	{
+		if (start)
+			next_of(start) = nullptr;
+		return start;
+	}
+	std::size_t half = len / 2;
+	N * mid = start;
+	for (std::size_t i = 0; i < half; i++)
+		mid = next_of(mid);
+	N * a = merge_sort(start, half, less);
+	N * b = merge_sort(mid, len - half, less);
+	N * out = nullptr;
+	N ** tailp = &out;
+	while (a && b)
+	{
+		N *& pick = less(value_of(b), value_of(a)) ? b : a;
+		*tailp = pick;
+		tailp = &next_of(pick);
+		pick = *tailp;
+	}
+	*tailp = a ? a : b;
+	return out;
+}
+
+// The item as a probe argument: integers and enums as they are, anything
+// else as 0.
+template <class T>
+long long probe_arg(const T & item)
+{
+	if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+		return static_cast<long long>(item);
+	else
+		return 0;
+}
+
+} // namespace engine_detail
+
+// Singly linked list (menu_linked.c). Keeps a tail so insert_end is O(1).
+template <class T>
+class sll
+{
+public:
+	using value_type = T;
+	using node = sll_node<T>;
+
+	explicit sll(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : mr_(mr) {}
+	~sll() { clear(); }
+
+	sll(sll && o) noexcept : mr_(o.mr_), start_(o.start_), tail_(o.tail_), len_(o.len_)
+	{
+		o.start_ = o.tail_ = nullptr;
+		o.len_ = 0;
+	}
+	sll & operator=(sll && o) noexcept
+	{
+		if (this != &o)
+		{
+			clear();
+			mr_ = o.mr_;
+			start_ = o.start_;
+			tail_ = o.tail_;
+			len_ = o.len_;
+			o.start_ = o.tail_ = nullptr;
+			o.len_ = 0;
+		}
+		return *this;
+	}
+	sll(const sll &) = delete;
+	sll & operator=(const sll &) = delete;
+
+	node * head() const { return start_; }
+	node * tail() const { return tail_; }
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+	std::pmr::memory_resource * resource() const { return mr_; }
+
+	template <class... A>
+	list_status emplace_beg(A &&... a)
+	{
+		DSA_TRACE_SCOPE("sll.insert_beg", "sll");
+		node * n = engine_detail::make_node<node>(mr_, std::forward<A>(a)...);
+		if (n == nullptr)
+			return list_status::overflow;
+		n->link = start_;
+		start_ = n;
+		if (tail_ == nullptr)
+			tail_ = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	template <class... A>
+	list_status emplace_end(A &&... a)
+	{
+		DSA_TRACE_SCOPE("sll.insert_end", "sll");
+		node * n = engine_detail::make_node<node>(mr_, std::forward<A>(a)...);
+		if (n == nullptr)
+			return list_status::overflow;
+		n->link = nullptr;
+		if (tail_)
+			tail_->link = n;
+		else
+			start_ = n;
+		tail_ = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status insert_beg(T item)
+	{
+		LIST_PROBE3(insert_beg_entry, this, len_, engine_detail::probe_arg(item));
+		list_status s = emplace_beg(std::move(item));
+		LIST_PROBE3(insert_beg_return, this, len_, s);
+		return s;
+	}
+
+	list_status insert_end(T item)
+	{
+		LIST_PROBE3(insert_end_entry, this, len_, engine_detail::probe_arg(item));
+		list_status s = emplace_end(std::move(item));
+		LIST_PROBE3(insert_end_return, this, len_, s);
+		return s;
+	}
+
+	list_status delete_beg(T * out = nullptr)
+	{
+		LIST_PROBE3(delete_beg_entry, this, len_, 0);
+		list_status s = unlink_beg(out);
+		LIST_PROBE3(delete_beg_return, this, len_, s);
+		return s;
+	}
+
+	list_status delete_end(T * out = nullptr)
+	{
+		LIST_PROBE3(delete_end_entry, this, len_, 0);
+		list_status s = unlink_end(out);
+		LIST_PROBE3(delete_end_return, this, len_, s);
+		return s;
+	}
+
+	// Appends a ready-made chain of `count` nodes, first..last, in O(1).
+	// The nodes must have been allocated from resource() (list_loader.hpp).
+	void splice_end(node * first, node * last, std::size_t count)
+	{
+		if (first == nullptr)
+			return;
+		last->link = nullptr;
+		if (tail_)
+			tail_->link = first;
+		else
+			start_ = first;
+		tail_ = last;
+		len_ += count;
+	}
+
+	// 1-based position like searching_sll, or 0 when absent.
+	std::size_t search(const T & item) const
+	{
+		DSA_TRACE_SCOPE_ARG("sll.search", "sll", std::int64_t(len_));
+		LIST_PROBE3(search_entry, this, len_, engine_detail::probe_arg(item));
+		std::size_t loc = 1;
+		node * ptr = start_;
+		while (ptr != nullptr && !(ptr->info == item))
+		{
+			ptr = ptr->link;
+			loc++;
+		}
+		LIST_PROBE_WALK(this, loc - 1, LIST_WALK_SEARCH);
+		if (ptr == nullptr)
+			loc = 0;
+		LIST_PROBE3(search_return, this, len_, loc);
+		return loc;
+	}
+
+	template <class Less = std::less<>>
+	void sort(Less less = Less())
+	{
+		DSA_TRACE_SCOPE_ARG("sll.sort", "sll", std::int64_t(len_));
+		{
+			DSA_TRACE_SCOPE("merge_sort", "sll");
+			start_ = engine_detail::merge_sort(start_, len_, less);
+		}
+		DSA_TRACE_SCOPE("find_tail", "sll");
+		tail_ = start_;
+		while (tail_ && tail_->link)
+			tail_ = tail_->link;
+	}
+
+	void reverse()
+	{
+		DSA_TRACE_SCOPE_ARG("sll.reverse", "sll", std::int64_t(len_));
+		node * ptr = start_, *prev = nullptr;
+		tail_ = start_;
+		while (ptr != nullptr)
+		{
+			node * temp = ptr->link;
+			ptr->link = prev;
+			prev = ptr;
+			ptr = temp;
+		}
+		start_ = prev;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (node * ptr = start_; ptr != nullptr; ptr = ptr->link)
+			f(ptr->info);
+	}
+
+	// Destroys and deallocates every node.
+	void clear()
+	{
+		node * ptr = start_;
+		while (ptr != nullptr)
+		{
+			node * temp = ptr->link;
+			engine_detail::drop_node(mr_, ptr);
+			ptr = temp;
+		}
+		start_ = tail_ = nullptr;
+		len_ = 0;
+	}
+
+	// Forgets every node without handing it back to the resource. Use when
+	// the resource is about to be released wholesale (monotonic arena).
+	// Payloads with destructors are still destroyed, which needs a walk.
+	void abandon()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (node * ptr = start_; ptr != nullptr; ptr = ptr->link)
+				ptr->info.~T();
+		start_ = tail_ = nullptr;
+		len_ = 0;
+	}
+
+private:
+	template <class> friend class stack;
+	template <class> friend class queue;
+
+	// delete_beg/delete_end without the probes, for the stack and queue,
+	// which fire their own.
+	list_status unlink_beg(T * out)
+	{
+		DSA_TRACE_SCOPE("sll.delete_beg", "sll");
+		if (start_ == nullptr)
+			return list_status::underflow;
+		node * ptr = start_;
+		if (out)
+			*out = std::move(ptr->info);
+		start_ = ptr->link;
+		if (start_ == nullptr)
+			tail_ = nullptr;
+		engine_detail::drop_node(mr_, ptr);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status unlink_end(T * out)
+	{
+		DSA_TRACE_SCOPE_ARG("sll.delete_end", "sll", std::int64_t(len_));
+		if (start_ == nullptr)
+			return list_status::underflow;
+		if (start_ == tail_)
+			return unlink_beg(out);
+		node * prev = start_;
+		while (prev->link != tail_)
+			prev = prev->link;
+		LIST_PROBE_WALK(this, len_ - 2, LIST_WALK_DELETE_END); // start_ to the node before tail_
+		if (out)
+			*out = std::move(tail_->info);
+		engine_detail::drop_node(mr_, tail_);
+		prev->link = nullptr;
+		tail_ = prev;
+		len_--;
+		return list_status::ok;
+	}
+
+	std::pmr::memory_resource * mr_;
+	node * start_ = nullptr;
+	node * tail_ = nullptr;
+	std::size_t len_ = 0;
+};
+
+// Doubly linked list (menu_DLL.c). Both ends are O(1).
+template <class T>
+class dll
+{
+public:
+	using value_type = T;
+	using node = dll_node<T>;
+
+	explicit dll(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : mr_(mr) {}
+	~dll() { clear(); }
+
+	dll(dll && o) noexcept : mr_(o.mr_), start_(o.start_), tail_(o.tail_), len_(o.len_)
+	{
+		o.start_ = o.tail_ = nullptr;
+		o.len_ = 0;
+	}
+	dll & operator=(dll && o) noexcept
+	{
+		if (this != &o)
+		{
+			clear();
+			mr_ = o.mr_;
+			start_ = o.start_;
+			tail_ = o.tail_;
+			len_ = o.len_;
+			o.start_ = o.tail_ = nullptr;
+			o.len_ = 0;
+		}
+		return *this;
+	}
+	dll(const dll &) = delete;
+	dll & operator=(const dll &) = delete;
+
+	node * head() const { return start_; }
+	node * tail() const { return tail_; }
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+	std::pmr::memory_resource * resource() const { return mr_; }
+
+	template <class... A>
+	list_status emplace_after(node * prev, A &&... a)
+	{
+		DSA_TRACE_SCOPE("dll.insert", "dll");
+		node * n = engine_detail::make_node<node>(mr_, std::forward<A>(a)...);
+		if (n == nullptr)
+			return list_status::overflow;
+		node * next = prev ? prev->next : start_;
+		n->prev = prev;
+		n->next = next;
+		(prev ? prev->next : start_) = n;
+		(next ? next->prev : tail_) = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status insert_beg(T item)
+	{
+		LIST_PROBE3(insert_beg_entry, this, len_, engine_detail::probe_arg(item));
+		list_status s = emplace_after(nullptr, std::move(item));
+		LIST_PROBE3(insert_beg_return, this, len_, s);
+		return s;
+	}
+
+	list_status insert_end(T item)
+	{
+		LIST_PROBE3(insert_end_entry, this, len_, engine_detail::probe_arg(item));
+		list_status s = emplace_after(tail_, std::move(item));
+		LIST_PROBE3(insert_end_return, this, len_, s);
+		return s;
+	}
+
+	// Inserts so the item becomes node number `loc` (1-based), like insert_LOC.
+	list_status insert_loc(T item, std::size_t loc)
+	{
+		DSA_TRACE_SCOPE_ARG("dll.insert_loc", "dll", std::int64_t(loc));
+		LIST_PROBE3(insert_loc_entry, this, len_, loc);
+		list_status s = list_status::not_found;
+		if (loc != 0 && loc <= len_ + 1)
+		{
+			node * prev = nullptr;
+			if (loc - 1 <= len_ / 2)
+			{
+				for (std::size_t i = 1; i < loc; i++)
+					prev = prev ? prev->next : start_;
+				LIST_PROBE_WALK(this, loc - 1, LIST_WALK_INSERT_LOC);
+			}
+			else
+			{
+				prev = tail_;
+				for (std::size_t i = len_; i >= loc; i--)
+					prev = prev->prev;
+				LIST_PROBE_WALK(this, len_ + 1 - loc, LIST_WALK_INSERT_LOC);
+			}
+			s = emplace_after(prev, std::move(item));
+		}
+		LIST_PROBE3(insert_loc_return, this, len_, s);
+		return s;
+	}
+
+	list_status remove(node * n, T * out = nullptr)
+	{
+		DSA_TRACE_SCOPE("dll.remove", "dll");
+		if (n == nullptr)
+			return list_status::underflow;
+		if (out)
+			*out = std::move(n->info);
+		(n->prev ? n->prev->next : start_) = n->next;
+		(n->next ? n->next->prev : tail_) = n->prev;
+		engine_detail::drop_node(mr_, n);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_beg(T * out = nullptr)
+	{
+		LIST_PROBE3(delete_beg_entry, this, len_, 0);
+		list_status s = remove(start_, out);
+		LIST_PROBE3(delete_beg_return, this, len_, s);
+		return s;
+	}
+
+	list_status delete_end(T * out = nullptr)
+	{
+		LIST_PROBE3(delete_end_entry, this, len_, 0);
+		list_status s = remove(tail_, out);
+		LIST_PROBE3(delete_end_return, this, len_, s);
+		return s;
+	}
+
+	std::size_t search(const T & item) const
+	{
+		DSA_TRACE_SCOPE_ARG("dll.search", "dll", std::int64_t(len_));
+		LIST_PROBE3(search_entry, this, len_, engine_detail::probe_arg(item));
+		std::size_t loc = 1;
+		node * ptr = start_;
+		while (ptr != nullptr && !(ptr->info == item))
+		{
+			ptr = ptr->next;
+			loc++;
+		}
+		LIST_PROBE_WALK(this, loc - 1, LIST_WALK_SEARCH);
+		if (ptr == nullptr)
+			loc = 0;
+		LIST_PROBE3(search_return, this, len_, loc);
+		return loc;
+	}
+
+	template <class Less = std::less<>>
+	void sort(Less less = Less())
+	{
+		DSA_TRACE_SCOPE_ARG("dll.sort", "dll", std::int64_t(len_));
+		{
+			DSA_TRACE_SCOPE("merge_sort", "dll");
+			start_ = engine_detail::merge_sort(start_, len_, less);
+		}
+		DSA_TRACE_SCOPE("relink_prev", "dll");
+		node * prev = nullptr;
+		for (node * ptr = start_; ptr != nullptr; ptr = ptr->next)
+		{
+			ptr->prev = prev;
+			prev = ptr;
+		}
+		tail_ = prev;
+	}
+
+	void reverse()
+	{
+		DSA_TRACE_SCOPE_ARG("dll.reverse", "dll", std::int64_t(len_));
+		for (node * ptr = start_; ptr != nullptr; ptr = ptr->prev)
+			std::swap(ptr->prev, ptr->next);
+		std::swap(start_, tail_);
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (node * ptr = start_; ptr != nullptr; ptr = ptr->next)
+			f(ptr->info);
+	}
+
+	void clear()
+	{
+		node * ptr = start_;
+		while (ptr != nullptr)
+		{
+			node * temp = ptr->next;
+			engine_detail::drop_node(mr_, ptr);
+			ptr = temp;
+		}
+		start_ = tail_ = nullptr;
+		len_ = 0;
+	}
+
+	void abandon()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (node * ptr = start_; ptr != nullptr; ptr = ptr->next)
+				ptr->info.~T();
+		start_ = tail_ = nullptr;
+		len_ = 0;
+	}
+
+private:
+	std::pmr::memory_resource * mr_;
+	node * start_ = nullptr;
+	node * tail_ = nullptr;
+	std::size_t len_ = 0;
+};
+
+// Linked stack (linked_stack_menu.c): push/pop at the head of an sll.
+template <class T>
+class stack
+{
+public:
+	explicit stack(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : list_(mr) {}
+
+	list_status push(T item)
+	{
+		LIST_PROBE3(push_entry, this, list_.len_, engine_detail::probe_arg(item));
+		list_status s = list_.emplace_beg(std::move(item));
+		LIST_PROBE3(push_return, this, list_.len_, s);
+		return s;
+	}
+
+	list_status pop(T * out = nullptr)
+	{
+		LIST_PROBE3(pop_entry, this, list_.len_, 0);
+		list_status s = list_.unlink_beg(out);
+		LIST_PROBE3(pop_return, this, list_.len_, s);
+		return s;
+	}
+	const T * peek() const { return list_.head() ? &list_.head()->info : nullptr; }
+
+	sll_node<T> * top() const { return list_.head(); }
+	std::size_t length() const { return list_.length(); }
+	bool empty() const { return list_.empty(); }
+
+	template <class F>
+	void for_each(F && f) const { list_.for_each(std::forward<F>(f)); }
+
+	void clear() { list_.clear(); }
+	void abandon() { list_.abandon(); }
+
+private:
+	sll<T> list_;
+};
+
+// Linked queue (linked_queue_menu.c): enqueue at the tail, dequeue at the head.
+template <class T>
+class queue
+{
+public:
+	explicit queue(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : list_(mr) {}
+
+	list_status enqueue(T item)
+	{
+		LIST_PROBE3(enqueue_entry, this, list_.len_, engine_detail::probe_arg(item));
+		list_status s = list_.emplace_end(std::move(item));
+		LIST_PROBE3(enqueue_return, this, list_.len_, s);
+		return s;
+	}
+
+	list_status dequeue(T * out = nullptr)
+	{
+		LIST_PROBE3(dequeue_entry, this, list_.len_, 0);
+		list_status s = list_.unlink_beg(out);
+		LIST_PROBE3(dequeue_return, this, list_.len_, s);
+		return s;
+	}
+
+	sll_node<T> * front() const { return list_.head(); }
+	sll_node<T> * rear() const { return list_.tail(); }
+	std::size_t length() const { return list_.length(); }
+	bool empty() const { return list_.empty(); }
+
+	template <class F>
+	void for_each(F && f) const { list_.for_each(std::forward<F>(f)); }
+
+	void clear() { list_.clear(); }
+	void abandon() { list_.abandon(); }
+
+private:
+	sll<T> list_;
+};
+
+} // namespace dsa
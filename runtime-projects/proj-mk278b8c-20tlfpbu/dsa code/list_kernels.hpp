@@ -0,0 +1,223 @@
+// Search and sum kernels over contiguous payload arrays (unrolled blocks,
+// frozen lists, static stacks, gap buffers), instantiated per integer width.
+//
+// With SSE2 a 16-byte vector holds 16 int8, 8 int16, 4 int32 or 2 int64
+// lanes, so narrower payloads are scanned with proportionally fewer
+// instructions. Signed and unsigned integers take the vector path for both
+// kernels; enums take it for find_first, compared by their underlying
+// type. Other types and targets use the scalar loop, which the compiler
+// may vectorise by itself.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace dsa {
+
+// Integer payload of an exact bit width: int_payload<8> is std::int8_t.
+template <unsigned Bits>
+using int_payload = std::conditional_t<Bits == 8, std::int8_t,
+	std::conditional_t<Bits == 16, std::int16_t,
+	std::conditional_t<Bits == 32, std::int32_t,
+	std::conditional_t<Bits == 64, std::int64_t, void>>>>;
+
+// Sums of integer payloads are carried in 64 bits (int64 sums wrap);
+// others in their own type.
+template <class T>
+using sum_type = std::conditional_t<std::is_integral_v<T>, std::int64_t, T>;
+
+namespace kernel_detail {
+
+template <class T>
+std::size_t find_scalar(const T * p, std::size_t i, std::size_t n, const T & key)
+{
+	for (; i < n; i++)
+		if (p[i] == key)
+			return i;
+	return n;
+}
+
+template <class T>
+sum_type<T> sum_scalar(const T * p, std::size_t i, std::size_t n)
+{
+	if constexpr (std::is_integral_v<T>)
+	{
+		std::uint64_t s = 0;
+		for (; i < n; i++)
+			s += std::uint64_t(std::int64_t(p[i]));
+		return std::int64_t(s);
+	}
+	else
+	{
+		T s = 0;
+		for (; i < n; i++)
+			s += p[i];
+		return s;
+	}
+}
+
+#if defined(__SSE2__)
+inline unsigned ctz32(unsigned v) { return unsigned(__builtin_ctz(v)); }
+
+inline __m128i splat(std::int8_t k) { return _mm_set1_epi8(k); }
+inline __m128i splat(std::int16_t k) { return _mm_set1_epi16(k); }
+inline __m128i splat(std::int32_t k) { return _mm_set1_epi32(k); }
+
+inline __m128i cmpeq(__m128i a, __m128i b, std::int8_t) { return _mm_cmpeq_epi8(a, b); }
+inline __m128i cmpeq(__m128i a, __m128i b, std::int16_t) { return _mm_cmpeq_epi16(a, b); }
+inline __m128i cmpeq(__m128i a, __m128i b, std::int32_t) { return _mm_cmpeq_epi32(a, b); }
+
+template <class T>
+std::size_t find_sse2(const T * p, std::size_t n, T key)
+{
+	constexpr std::size_t lanes = 16 / sizeof(T);
+	std::size_t i = 0;
+	if constexpr (sizeof(T) == 8)
+	{
+		// No 64-bit compare in SSE2: both 32-bit halves must match.
+		__m128i k = _mm_set1_epi64x(std::int64_t(key));
+		for (; i + lanes <= n; i += lanes)
+		{
+			int m = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)), k));
+			if ((m & 0xFF) == 0xFF)
+				return i;
+			if ((m >> 8) == 0xFF)
+				return i + 1;
+		}
+	}
+	else
+	{
+		// Equality only depends on the bits, so unsigned and enum keys use
+		// the signed lanes of their width. Overloads are picked by exact
+		// width: plain char would otherwise promote to int and be compared
+		// as 32-bit lanes.
+		using W = int_payload<8 * sizeof(T)>;
+		__m128i k = splat(W(key));
+		for (; i + lanes <= n; i += lanes)
+		{
+			unsigned m = unsigned(_mm_movemask_epi8(cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)), k, W())));
+			if (m)
+				return i + ctz32(m) / sizeof(T);
+		}
+	}
+	return find_scalar(p, i, n, key);
+}
+
+inline std::int64_t hsum64(__m128i v)
+{
+	alignas(16) std::int64_t out[2];
+	_mm_store_si128(reinterpret_cast<__m128i *>(out), v);
+	return std::int64_t(std::uint64_t(out[0]) + std::uint64_t(out[1]));
+}
+
+template <class T>
+std::int64_t sum_sse2(const T * p, std::size_t n)
+{
+	constexpr std::size_t lanes = 16 / sizeof(T);
+	std::size_t i = 0;
+	__m128i acc = _mm_setzero_si128(); // two int64 lanes
+	const __m128i zero = _mm_setzero_si128();
+	if constexpr (sizeof(T) == 1)
+	{
+		// psadbw adds 8 unsigned bytes at a time into int64 lanes; signed
+		// bytes are biased to unsigned first and the bias taken off after.
+		if constexpr (std::is_unsigned_v<T>)
+		{
+			for (; i + lanes <= n; i += lanes)
+				acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)), zero));
+			return hsum64(acc) + sum_scalar(p, i, n);
+		}
+		else
+		{
+			const __m128i bias = _mm_set1_epi8(char(0x80));
+			for (; i + lanes <= n; i += lanes)
+				acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)), bias), zero));
+			return hsum64(acc) - 128 * std::int64_t(i) + sum_scalar(p, i, n);
+		}
+	}
+	else if constexpr (sizeof(T) == 2)
+	{
+		// pmaddwd folds pairs of signed words into int32; spill to int64
+		// before they can overflow. Unsigned words are biased to signed and
+		// the bias added back after.
+		const __m128i ones = _mm_set1_epi16(1);
+		const __m128i bias = std::is_unsigned_v<T> ? _mm_set1_epi16(std::int16_t(0x8000)) : zero;
+		while (i + lanes <= n)
+		{
+			__m128i acc32 = _mm_setzero_si128();
+			std::size_t stop = n - (n - i) % lanes;
+			if (stop - i > lanes * 16384)
+				stop = i + lanes * 16384;
+			for (; i < stop; i += lanes)
+				acc32 = _mm_add_epi32(acc32, _mm_madd_epi16(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)), bias), ones));
+			__m128i sign = _mm_srai_epi32(acc32, 31);
+			acc = _mm_add_epi64(acc, _mm_add_epi64(_mm_unpacklo_epi32(acc32, sign), _mm_unpackhi_epi32(acc32, sign)));
+		}
+		std::int64_t unbias = std::is_unsigned_v<T> ? 32768 * std::int64_t(i) : 0;
+		return hsum64(acc) + unbias + sum_scalar(p, i, n);
+	}
+	else if constexpr (sizeof(T) == 4)
+	{
+		// Widened to int64 by sign, or for unsigned items by zero.
+		for (; i + lanes <= n; i += lanes)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+			__m128i hi = std::is_unsigned_v<T> ? zero : _mm_srai_epi32(v, 31);
+			acc = _mm_add_epi64(acc, _mm_add_epi64(_mm_unpacklo_epi32(v, hi), _mm_unpackhi_epi32(v, hi)));
+		}
+		return hsum64(acc) + sum_scalar(p, i, n);
+	}
+	else
+	{
+		for (; i + lanes <= n; i += lanes)
+			acc = _mm_add_epi64(acc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)));
+		return std::int64_t(std::uint64_t(hsum64(acc)) + std::uint64_t(sum_scalar(p, i, n)));
+	}
+}
+#endif
+
+template <class T>
+constexpr bool simd_int = std::is_integral_v<T> &&
+	(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) && !std::is_same_v<T, bool>;
+
+// Enums are searched as their underlying integer.
+template <class T, bool = std::is_enum_v<T>>
+struct lane
+{
+	using type = T;
+};
+template <class T>
+struct lane<T, true>
+{
+	using type = std::underlying_type_t<T>;
+};
+template <class T>
+using lane_t = typename lane<T>::type;
+
+} // namespace kernel_detail
+
+// Index of the first item equal to key, or n.
+template <class T>
+std::size_t find_first(const T * p, std::size_t n, const T & key)
+{
+#if defined(__SSE2__)
+	if constexpr (kernel_detail::simd_int<kernel_detail::lane_t<T>>)
+		return kernel_detail::find_sse2(p, n, key);
+#endif
+	return kernel_detail::find_scalar(p, 0, n, key);
+}
+
+template <class T>
+sum_type<T> sum(const T * p, std::size_t n)
+{
+#if defined(__SSE2__)
+	if constexpr (kernel_detail::simd_int<T>)
+		return kernel_detail::sum_sse2(p, n);
+#endif
+	return kernel_detail::sum_scalar(p, 0, n);
+}
+
+} // namespace dsa
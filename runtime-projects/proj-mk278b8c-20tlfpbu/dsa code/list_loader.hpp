@@ -0,0 +1,295 @@
+// Parallel list construction from large text files of integers.
+//
+//   dsa::node_pool pool(sizeof(dsa::sll_node<int>));
+//   dsa::sll<int> list(&pool);
+//   dsa::thread_pool workers;
+//   dsa::load_stats st;
+//   if (dsa::load_list("items.txt", list, workers, &st) != dsa::list_status::ok) ...
+//
+// The file is mmapped and cut into one part per thread, each cut moved
+// forward to the next line start. Every part is parsed (whitespace-separated
+// integers, as scanf("%d") reads them) into its own chain, with nodes from
+// a node_pool private to that part, so no allocator state is shared. The
+// finished chains are linked in file order with one write per part, their
+// pools are adopted by the list's pool, and the whole chain is appended to
+// the list in O(1). Nothing is copied after parsing.
+//
+// With a list whose resource is not a node_pool, the parts still parse in
+// parallel into arrays, and the nodes are then allocated on the calling
+// thread.
+//
+// Tokens that are not integers, or do not fit T, are skipped and counted
+// in load_stats::rejected. On error the list is left unchanged: not_found
+// when the file cannot be opened or mapped, overflow when nodes cannot be
+// allocated or the part pools cannot be handed to the list's pool.
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "list_engine.hpp"
+#include "list_trace.hpp"
+#include "node_pool.hpp"
+#include "thread_pool.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dsa {
+
+struct load_stats
+{
+	std::size_t bytes = 0;
+	std::size_t parts = 0;
+	std::size_t items = 0;
+	std::size_t rejected = 0; // tokens that were not integers of the list's type
+};
+
+// Parts smaller than this are not worth a thread.
+constexpr std::size_t load_min_part = std::size_t(1) << 20;
+
+namespace load_detail {
+
+// Read-only view of a whole file: mmapped where possible, read otherwise.
+class file_view
+{
+public:
+	explicit file_view(const char * path)
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		int fd = open(path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			return;
+		struct stat st;
+		if (fstat(fd, &st) == 0)
+		{
+			ok_ = st.st_size == 0; // nothing to map
+			void * p = ok_ ? MAP_FAILED : mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p != MAP_FAILED)
+			{
+				data_ = static_cast<const char *>(p);
+				size_ = std::size_t(st.st_size);
+				mapped_ = ok_ = true;
+#if defined(MADV_SEQUENTIAL)
+				madvise(p, size_, MADV_SEQUENTIAL); // each part is read front to back
+#endif
+			}
+		}
+		close(fd);
+#else
+		std::FILE * f = std::fopen(path, "rb");
+		if (f == nullptr)
+			return;
+		char buf[1 << 16];
+		std::size_t n;
+		while ((n = std::fread(buf, 1, sizeof buf, f)) > 0)
+			copy_.insert(copy_.end(), buf, buf + n);
+		ok_ = !std::ferror(f);
+		std::fclose(f);
+		data_ = copy_.data();
+		size_ = copy_.size();
+#endif
+	}
+
+	~file_view()
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		if (mapped_)
+			munmap(const_cast<char *>(data_), size_);
+#endif
+	}
+
+	file_view(const file_view &) = delete;
+	file_view & operator=(const file_view &) = delete;
+
+	bool ok() const { return ok_; }
+	const char * data() const { return data_; }
+	std::size_t size() const { return size_; }
+
+private:
+	const char * data_ = nullptr;
+	std::size_t size_ = 0;
+	bool mapped_ = false;
+	bool ok_ = false;
+#if !(defined(__unix__) || defined(__APPLE__))
+	std::vector<char> copy_;
+#endif
+};
+
+inline bool is_space(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+// Calls emit(value) for every integer token in [p, end), in order.
+// Returns the number of tokens rejected.
+template <class T, class Emit>
+std::size_t parse(const char * p, const char * end, Emit && emit)
+{
+	std::size_t rejected = 0;
+	for (;;)
+	{
+		while (p < end && is_space(*p))
+			p++;
+		if (p == end)
+			return rejected;
+		const char * tok = p;
+		while (p < end && !is_space(*p))
+			p++;
+		// from_chars takes '-' but not the '+' scanf also accepts.
+		const char * digits = tok + (*tok == '+' && p - tok > 1 && tok[1] != '-');
+		T v;
+		auto r = std::from_chars(digits, p, v);
+		if (r.ec == std::errc() && r.ptr == p)
+			emit(v);
+		else
+			rejected++;
+	}
+}
+
+// Part boundaries: `parts` equal byte ranges, each start moved past the
+// next newline so no line is split.
+inline std::vector<const char *> cut(const char * data, std::size_t size, std::size_t parts)
+{
+	std::vector<const char *> at{data};
+	const char * end = data + size;
+	for (std::size_t i = 1; i < parts; i++)
+	{
+		const char * p = data + size / parts * i;
+		if (p < at.back())
+			p = at.back();
+		while (p < end && *p != '\n')
+			p++;
+		if (p < end)
+			p++;
+		if (p > at.back() && p < end)
+			at.push_back(p);
+	}
+	at.push_back(end);
+	return at;
+}
+
+} // namespace load_detail
+
+// Appends every integer in the file at `path` to `out`, in file order.
+template <class T>
+list_status load_list(const char * path, sll<T> & out, thread_pool & workers, load_stats * stats = nullptr)
+{
+	static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "load_list parses integer items");
+	using node = sll_node<T>;
+	DSA_TRACE_SCOPE("load", "loader");
+	load_detail::file_view file(path);
+	if (!file.ok())
+		return list_status::not_found;
+
+	std::size_t want = file.size() / load_min_part;
+	if (want > workers.size() + 1)
+		want = workers.size() + 1; // run_n also runs a part on the caller
+	if (want == 0)
+		want = 1;
+	std::vector<const char *> at = load_detail::cut(file.data(), file.size(), want);
+	const std::size_t parts = at.size() - 1;
+
+	struct part
+	{
+		node * first = nullptr;
+		node * last = nullptr;
+		std::size_t count = 0;
+		std::size_t rejected = 0;
+		bool failed = false;
+		std::unique_ptr<node_pool> pool;
+		std::vector<T> items; // when the list's resource is not a node_pool
+	};
+	std::vector<part> seg(parts);
+	node_pool * target = dynamic_cast<node_pool *>(out.resource());
+	if (target)
+		for (part & s : seg) // same geometry as target, so adopt() takes them
+			s.pool = std::make_unique<node_pool>(target->node_size(), target->node_align());
+
+	workers.run_n(parts, [&](std::size_t i) {
+		DSA_TRACE_SCOPE_ARG("load.part", "loader", std::int64_t(at[i + 1] - at[i]));
+		part & s = seg[i];
+		if (!s.pool)
+		{
+			s.rejected = load_detail::parse<T>(at[i], at[i + 1], [&](T v) { s.items.push_back(v); });
+			return;
+		}
+		// Linked as they are made: the chain is built front to back with
+		// one store per node into the previous one.
+		node * prev = nullptr;
+		s.rejected = load_detail::parse<T>(at[i], at[i + 1], [&](T v) {
+			if (s.failed)
+				return;
+			node * n = engine_detail::make_node<node>(s.pool.get(), v);
+			if (n == nullptr)
+			{
+				s.failed = true;
+				return;
+			}
+			(prev ? prev->link : s.first) = n;
+			prev = n;
+			s.count++;
+		});
+		if (prev)
+			prev->link = nullptr;
+		s.last = prev;
+	});
+
+	load_stats st;
+	st.bytes = file.size();
+	st.parts = parts;
+	for (const part & s : seg)
+	{
+		if (s.failed)
+			return list_status::overflow; // the part pools free every node
+		st.items += s.count + s.items.size();
+		st.rejected += s.rejected;
+	}
+
+	if (target)
+	{
+		DSA_TRACE_SCOPE_ARG("load.splice", "loader", std::int64_t(parts));
+		// Every pool is adopted before any chain is linked: a part whose
+		// pool stayed behind would free its nodes on return.
+		for (std::size_t i = 0; i < parts; i++)
+		{
+			if (target->adopt(*seg[i].pool))
+				continue;
+			for (std::size_t j = 0; j < i; j++) // already target's; free them there
+				for (node * n = seg[j].first; n != nullptr;)
+				{
+					node * next = n->link;
+					engine_detail::drop_node(target, n);
+					n = next;
+				}
+			return list_status::overflow;
+		}
+		node * first = nullptr, *last = nullptr;
+		for (const part & s : seg)
+		{
+			if (s.first == nullptr)
+				continue;
+			(last ? last->link : first) = s.first;
+			last = s.last;
+		}
+		out.splice_end(first, last, st.items);
+	}
+	else
+	{
+		DSA_TRACE_SCOPE_ARG("load.insert", "loader", std::int64_t(st.items));
+		sll<T> built(out.resource());
+		for (const part & s : seg)
+			for (T v : s.items)
+				if (built.insert_end(v) != list_status::ok)
+					return list_status::overflow;
+		out.splice_end(built.head(), built.tail(), built.length());
+		built.abandon(); // the nodes now belong to out
+	}
+	if (stats)
+		*stats = st;
+	return list_status::ok;
+}
+
+} // namespace dsa
@@ -0,0 +1,236 @@
+// Load generator for list_server.
+//
+//   g++ -std=c++17 -O2 -pthread list_loadgen.cpp -o list_loadgen
+//   ./list_loadgen [-s path] [-c clients] [-b ops per frame] [-d frames in flight] [-t seconds]
+//
+// Each client thread opens its own connection and creates its own queue.
+// It then keeps `d` request frames of `b` ops in flight, alternating
+// enqueue and dequeue so the queue stays short. A new frame goes out as
+// each reply comes back. It reports ops/s over all clients and the
+// round-trip time of a frame (b = 1, d = 1 is the single-op round trip).
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "list_protocol.h"
+
+namespace {
+
+using steady = std::chrono::steady_clock;
+
+struct options
+{
+	const char * path = LP_DEFAULT_PATH;
+	int clients = 1;
+	std::uint32_t batch = 64;
+	std::uint32_t depth = 4;
+	double seconds = 3;
+};
+
+struct client_result
+{
+	std::uint64_t ops = 0;
+	std::uint64_t errors = 0;
+	std::vector<double> rtt_us;
+	bool failed = false;
+};
+
+bool send_all(int fd, const void * p, std::size_t n)
+{
+	const char * c = static_cast<const char *>(p);
+	while (n > 0)
+	{
+		ssize_t w = send(fd, c, n, MSG_NOSIGNAL);
+		if (w <= 0)
+			return false;
+		c += w;
+		n -= std::size_t(w);
+	}
+	return true;
+}
+
+bool recv_all(int fd, void * p, std::size_t n)
+{
+	char * c = static_cast<char *>(p);
+	while (n > 0)
+	{
+		ssize_t r = recv(fd, c, n, 0);
+		if (r <= 0)
+			return false;
+		c += r;
+		n -= std::size_t(r);
+	}
+	return true;
+}
+
+int connect_to(const char * path)
+{
+	sockaddr_un addr{};
+	if (std::strlen(path) >= sizeof addr.sun_path)
+		return -1;
+	addr.sun_family = AF_UNIX;
+	std::strcpy(addr.sun_path, path);
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof addr) < 0)
+	{
+		close(fd);
+		fd = -1;
+	}
+	return fd;
+}
+
+// One request frame: header plus ops. The ops alternate over the whole
+// stream rather than within a frame, so odd batch sizes (and b = 1) still
+// issue as many dequeues as enqueues.
+struct frame_buffer
+{
+	std::vector<char> bytes;
+
+	void build(std::uint32_t seq, std::uint32_t list, std::uint32_t count, std::uint8_t first_op, std::uint8_t second_op, std::int64_t base)
+	{
+		bytes.resize(sizeof(lp_frame) + std::size_t(count) * sizeof(lp_op));
+		lp_frame f{count, seq};
+		std::memcpy(bytes.data(), &f, sizeof f);
+		for (std::uint32_t i = 0; i < count; i++)
+		{
+			lp_op op{};
+			op.op = (std::uint64_t(seq - 1) * count + i) % 2 ? second_op : first_op;
+			op.list = list;
+			op.arg = base + i;
+			std::memcpy(bytes.data() + sizeof f + std::size_t(i) * sizeof op, &op, sizeof op);
+		}
+	}
+};
+
+void run_client(const options & opt, int id, const std::atomic<bool> & stop, client_result & res)
+{
+	int fd = connect_to(opt.path);
+	if (fd < 0)
+	{
+		res.failed = true;
+		return;
+	}
+	const std::uint32_t list = 1000u + std::uint32_t(id);
+	frame_buffer fb;
+	std::vector<lp_result> results(std::max<std::uint32_t>(opt.batch, 2));
+
+	// Setup: drop a leftover list of that id, then create the queue.
+	lp_op setup[2] = {};
+	setup[0].op = LP_DROP;
+	setup[0].list = list;
+	setup[1].op = LP_CREATE;
+	setup[1].list = list;
+	setup[1].arg = LP_QUEUE;
+	lp_frame f{2, 0};
+	if (!send_all(fd, &f, sizeof f) || !send_all(fd, setup, sizeof setup) || !recv_all(fd, &f, sizeof f) ||
+		f.count != 2 || !recv_all(fd, results.data(), 2 * sizeof(lp_result)) || results[1].status != LP_OK)
+	{
+		res.failed = true;
+		close(fd);
+		return;
+	}
+
+	std::vector<steady::time_point> sent(opt.depth);
+	std::uint32_t next_seq = 1, done = 0;
+	auto send_next = [&]() {
+		fb.build(next_seq, list, opt.batch, LP_ENQUEUE, LP_DEQUEUE, std::int64_t(next_seq) * opt.batch);
+		sent[next_seq % opt.depth] = steady::now();
+		next_seq++;
+		return send_all(fd, fb.bytes.data(), fb.bytes.size());
+	};
+	for (std::uint32_t i = 0; i < opt.depth; i++)
+		if (!send_next())
+			res.failed = true;
+	while (!res.failed && done + 1 < next_seq)
+	{
+		if (!recv_all(fd, &f, sizeof f) || f.count != opt.batch || !recv_all(fd, results.data(), f.count * sizeof(lp_result)))
+		{
+			res.failed = true;
+			break;
+		}
+		double us = std::chrono::duration<double, std::micro>(steady::now() - sent[f.seq % opt.depth]).count();
+		res.rtt_us.push_back(us);
+		done++;
+		res.ops += f.count;
+		for (std::uint32_t i = 0; i < f.count; i++)
+			res.errors += results[i].status != LP_OK;
+		if (!stop.load(std::memory_order_relaxed) && !send_next())
+			res.failed = true;
+	}
+	close(fd);
+}
+
+double percentile(std::vector<double> & v, double p)
+{
+	if (v.empty())
+		return 0;
+	std::size_t k = std::size_t(p * double(v.size() - 1));
+	std::nth_element(v.begin(), v.begin() + std::ptrdiff_t(k), v.end());
+	return v[k];
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+	options opt;
+	int c;
+	while ((c = getopt(argc, argv, "s:c:b:d:t:")) != -1)
+	{
+		switch (c)
+		{
+		case 's': opt.path = optarg; break;
+		case 'c': opt.clients = std::max(1, std::atoi(optarg)); break;
+		case 'b': opt.batch = std::uint32_t(std::max(1, std::atoi(optarg))); break;
+		case 'd': opt.depth = std::uint32_t(std::max(1, std::atoi(optarg))); break;
+		case 't': opt.seconds = std::atof(optarg); break;
+		default:
+			std::fprintf(stderr, "usage: %s [-s path] [-c clients] [-b batch] [-d depth] [-t seconds]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (opt.batch > LP_MAX_BATCH)
+		opt.batch = LP_MAX_BATCH;
+
+	std::atomic<bool> stop{false};
+	std::vector<client_result> results(std::size_t(opt.clients));
+	std::vector<std::thread> threads;
+	auto t0 = steady::now();
+	for (int i = 0; i < opt.clients; i++)
+		threads.emplace_back(run_client, std::cref(opt), i, std::cref(stop), std::ref(results[std::size_t(i)]));
+	std::this_thread::sleep_for(std::chrono::duration<double>(opt.seconds));
+	stop.store(true);
+	for (auto & t : threads)
+		t.join();
+	double secs = std::chrono::duration<double>(steady::now() - t0).count();
+
+	std::uint64_t ops = 0, errors = 0;
+	int failed = 0;
+	std::vector<double> rtt;
+	for (auto & r : results)
+	{
+		ops += r.ops;
+		errors += r.errors;
+		failed += r.failed;
+		rtt.insert(rtt.end(), r.rtt_us.begin(), r.rtt_us.end());
+	}
+	if (failed == opt.clients)
+	{
+		std::fprintf(stderr, "could not talk to %s\n", opt.path);
+		return 1;
+	}
+	std::printf("clients=%d batch=%u depth=%u\n", opt.clients, opt.batch, opt.depth);
+	std::printf("ops=%llu  %.0f ops/s  errors=%llu  failed clients=%d\n",
+		static_cast<unsigned long long>(ops), double(ops) / secs, static_cast<unsigned long long>(errors), failed);
+	std::printf("frame rtt us: p50=%.1f p99=%.1f max=%.1f\n",
+		percentile(rtt, 0.5), percentile(rtt, 0.99), rtt.empty() ? 0.0 : *std::max_element(rtt.begin(), rtt.end()));
+	return 0;
+}
@@ -0,0 +1,427 @@
+// Live metrics for list-backed processes, exported in Prometheus text
+// format by a background thread.
+//
+//   dsa::list_metrics queue_m("jobs", "queue");      // one per structure
+//   dsa::pool_metrics pool_m("nodes");
+//   dsa::metrics_registry reg;
+//   reg.add(queue_m);
+//   reg.add(pool_m);
+//   dsa::metrics_exporter exp(reg, "unix:/tmp/jobs.metrics");  // or a file path
+//
+//   queue_m.count(dsa::metric_op::insert_end);       // hot path
+//   queue_m.add_length(1);
+//   pool_m.publish(pool);                            // now and then
+//
+//   $ curl -s --unix-socket /tmp/jobs.metrics http://x/metrics
+//
+// Every metric is a relaxed atomic with one writer, the thread that owns
+// the structure: an update is a plain load and store with no lock and no
+// locked instruction. The exporter reads the same atomics, so it never
+// stops the owner. The registry mutex only guards the registration list.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace dsa {
+
+enum class metric_op { insert_beg, insert_end, delete_beg, delete_end, search, other };
+
+namespace metrics_detail {
+
+constexpr std::size_t op_kinds = 6;
+constexpr const char * op_names[op_kinds] = {"insert_beg", "insert_end", "delete_beg", "delete_end", "search", "other"};
+
+// Single-writer add: no read-modify-write instruction needed.
+inline void bump(std::atomic<std::uint64_t> & a, std::uint64_t n)
+{
+	a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// A metric family: the exposition format wants its TYPE line followed by
+// all of its samples as one group, so the registry renders family by
+// family across every registered object.
+struct family
+{
+	const char * name;
+	const char * type;
+};
+
+inline void append(std::string & out, const char * fmt, ...) __attribute__((format(printf, 2, 3)));
+
+inline void append(std::string & out, const char * fmt, ...)
+{
+	char buf[512];
+	va_list ap;
+	va_start(ap, fmt);
+	int n = std::vsnprintf(buf, sizeof buf, fmt, ap);
+	va_end(ap);
+	if (n > 0)
+		out.append(buf, std::size_t(n) < sizeof buf ? std::size_t(n) : sizeof buf - 1);
+}
+
+} // namespace metrics_detail
+
+// Latency histogram with power-of-two buckets from 64 ns to about 2 s.
+class latency_histogram
+{
+public:
+	static constexpr std::size_t buckets = 26;     // finite buckets
+	static constexpr unsigned first_shift = 6;     // bucket 0 is <= 64 ns
+
+	void record(std::uint64_t ns)
+	{
+		std::size_t b = 0;
+		if (ns > (std::uint64_t(1) << first_shift))
+		{
+			b = std::size_t(64 - __builtin_clzll(ns - 1)) - first_shift;
+			if (b > buckets)
+				b = buckets; // +Inf
+		}
+		metrics_detail::bump(counts_[b], 1);
+		metrics_detail::bump(sum_ns_, ns);
+	}
+
+	// Times a scope into the histogram.
+	class timer
+	{
+	public:
+		explicit timer(latency_histogram & h) : h_(h), t0_(std::chrono::steady_clock::now()) {}
+		~timer()
+		{
+			h_.record(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0_).count()));
+		}
+		timer(const timer &) = delete;
+		timer & operator=(const timer &) = delete;
+
+	private:
+		latency_histogram & h_;
+		std::chrono::steady_clock::time_point t0_;
+	};
+
+	void render(std::string & out, const char * metric, const char * labels) const
+	{
+		std::uint64_t cum = 0;
+		for (std::size_t b = 0; b <= buckets; b++)
+		{
+			cum += counts_[b].load(std::memory_order_relaxed);
+			if (b < buckets)
+				metrics_detail::append(out, "%s_bucket{%s,le=\"%.9g\"} %llu\n", metric, labels,
+					double(std::uint64_t(1) << (first_shift + b)) * 1e-9, static_cast<unsigned long long>(cum));
+			else
+				metrics_detail::append(out, "%s_bucket{%s,le=\"+Inf\"} %llu\n", metric, labels, static_cast<unsigned long long>(cum));
+		}
+		metrics_detail::append(out, "%s_sum{%s} %.9g\n", metric, labels, double(sum_ns_.load(std::memory_order_relaxed)) * 1e-9);
+		metrics_detail::append(out, "%s_count{%s} %llu\n", metric, labels, static_cast<unsigned long long>(cum));
+	}
+
+private:
+	std::atomic<std::uint64_t> counts_[buckets + 1] = {};
+	std::atomic<std::uint64_t> sum_ns_{0};
+};
+
+// Counters of one list, stack or queue, labelled list="name" and, when
+// given, kind="kind".
+class list_metrics
+{
+public:
+	explicit list_metrics(std::string name, std::string kind = std::string())
+		: name_(std::move(name)), labels_("list=\"" + name_ + "\"")
+	{
+		if (!kind.empty())
+			labels_ += ",kind=\"" + kind + "\"";
+	}
+
+	const std::string & name() const { return name_; }
+
+	void count(metric_op op, std::uint64_t n = 1) { metrics_detail::bump(ops_[std::size_t(op)], n); }
+	void count_error() { metrics_detail::bump(errors_, 1); }
+	void set_length(std::size_t n) { length_.store(std::int64_t(n), std::memory_order_relaxed); }
+	void add_length(std::int64_t d) { length_.store(length_.load(std::memory_order_relaxed) + d, std::memory_order_relaxed); }
+
+	latency_histogram & latency() { return latency_; }
+
+	static constexpr metrics_detail::family families[] = {
+		{"dsa_list_ops_total", "counter"},
+		{"dsa_list_errors_total", "counter"},
+		{"dsa_list_length", "gauge"},
+		{"dsa_list_op_seconds", "histogram"},
+	};
+
+	// Samples of families[f] for this list.
+	void render(std::string & out, std::size_t f) const
+	{
+		const char * l = labels_.c_str();
+		switch (f)
+		{
+		case 0:
+			for (std::size_t i = 0; i < metrics_detail::op_kinds; i++)
+				metrics_detail::append(out, "dsa_list_ops_total{%s,op=\"%s\"} %llu\n", l, metrics_detail::op_names[i],
+					static_cast<unsigned long long>(ops_[i].load(std::memory_order_relaxed)));
+			break;
+		case 1:
+			metrics_detail::append(out, "dsa_list_errors_total{%s} %llu\n", l,
+				static_cast<unsigned long long>(errors_.load(std::memory_order_relaxed)));
+			break;
+		case 2:
+			metrics_detail::append(out, "dsa_list_length{%s} %lld\n", l,
+				static_cast<long long>(length_.load(std::memory_order_relaxed)));
+			break;
+		case 3:
+			latency_.render(out, "dsa_list_op_seconds", l);
+			break;
+		}
+	}
+
+private:
+	std::string name_;
+	std::string labels_;
+	std::atomic<std::uint64_t> ops_[metrics_detail::op_kinds] = {};
+	std::atomic<std::uint64_t> errors_{0};
+	std::atomic<std::int64_t> length_{0};
+	latency_histogram latency_;
+};
+
+// Occupancy of a node_pool. The pool's own stats are plain fields owned by
+// its thread, so the owner copies them here with publish().
+class pool_metrics
+{
+public:
+	explicit pool_metrics(std::string name) : name_(std::move(name)) {}
+
+	static constexpr metrics_detail::family families[] = {
+		{"dsa_pool_chunks", "gauge"},
+		{"dsa_pool_empty_chunks", "gauge"},
+		{"dsa_pool_trimmed_chunks", "gauge"},
+		{"dsa_pool_live_nodes", "gauge"},
+		{"dsa_pool_trims_total", "counter"},
+		{"dsa_pool_resident_bytes", "gauge"},
+	};
+
+	template <class Pool>
+	void publish(const Pool & p)
+	{
+		const auto & s = p.stats();
+		const std::size_t v[] = {s.chunks, s.empty_chunks, s.trimmed_chunks, s.live_nodes, s.trims, p.resident_bytes()};
+		for (std::size_t f = 0; f < std::size(families); f++)
+			values_[f].store(v[f], std::memory_order_relaxed);
+	}
+
+	// The one sample of families[f] for this pool.
+	void render(std::string & out, std::size_t f) const
+	{
+		metrics_detail::append(out, "%s{pool=\"%s\"} %llu\n", families[f].name, name_.c_str(),
+			static_cast<unsigned long long>(values_[f].load(std::memory_order_relaxed)));
+	}
+
+private:
+	std::string name_;
+	std::atomic<std::size_t> values_[std::size(families)] = {}; // in families order
+};
+
+// What the exporter shows. Registered objects must outlive the exporter
+// or be removed first.
+class metrics_registry
+{
+public:
+	void add(const list_metrics & m) { std::lock_guard<std::mutex> lk(mu_); lists_.push_back(&m); }
+	void add(const pool_metrics & m) { std::lock_guard<std::mutex> lk(mu_); pools_.push_back(&m); }
+
+	void remove(const list_metrics & m) { erase(lists_, &m); }
+	void remove(const pool_metrics & m) { erase(pools_, &m); }
+
+	std::string render() const
+	{
+		std::string out;
+		std::lock_guard<std::mutex> lk(mu_);
+		render_families(out, lists_);
+		render_families(out, pools_);
+		return out;
+	}
+
+private:
+	// Each family's TYPE line, then its samples for every object.
+	template <class T>
+	static void render_families(std::string & out, const std::vector<const T *> & objs)
+	{
+		std::size_t f = 0;
+		for (const metrics_detail::family & fam : T::families)
+		{
+			metrics_detail::append(out, "# TYPE %s %s\n", fam.name, fam.type);
+			for (const T * m : objs)
+				m->render(out, f);
+			f++;
+		}
+	}
+
+	template <class T>
+	void erase(std::vector<const T *> & v, const T * p)
+	{
+		std::lock_guard<std::mutex> lk(mu_);
+		for (std::size_t i = 0; i < v.size(); i++)
+			if (v[i] == p)
+			{
+				v.erase(v.begin() + std::ptrdiff_t(i));
+				return;
+			}
+	}
+
+	mutable std::mutex mu_;
+	std::vector<const list_metrics *> lists_;
+	std::vector<const pool_metrics *> pools_;
+};
+
+// Background thread publishing a registry. A target of "unix:/path" serves
+// a snapshot to each connection on that socket, answering HTTP GETs with an
+// HTTP response and anything else with the bare text; a path that exists
+// and is not a socket is left alone and nothing is served. Any other target is
+// a file, rewritten every interval through a rename, as for the
+// node_exporter textfile collector.
+class metrics_exporter
+{
+public:
+	metrics_exporter(const metrics_registry & reg, std::string target,
+		std::chrono::milliseconds interval = std::chrono::milliseconds(1000))
+		: reg_(reg), target_(std::move(target)), interval_(interval)
+	{
+		thread_ = std::thread([this] { run(); });
+	}
+
+	~metrics_exporter()
+	{
+		stop_.store(true);
+		thread_.join();
+	}
+
+	metrics_exporter(const metrics_exporter &) = delete;
+	metrics_exporter & operator=(const metrics_exporter &) = delete;
+
+	std::size_t snapshots() const { return snapshots_.load(std::memory_order_relaxed); }
+
+private:
+	void run()
+	{
+		if (target_.compare(0, 5, "unix:") == 0)
+			serve(target_.substr(5));
+		else
+			write_files();
+	}
+
+	void write_files()
+	{
+		std::string tmp = target_ + ".tmp";
+		while (!stop_.load())
+		{
+			std::string text = reg_.render();
+			if (std::FILE * f = std::fopen(tmp.c_str(), "w"))
+			{
+				bool ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+				ok = std::fclose(f) == 0 && ok;
+				if (ok && std::rename(tmp.c_str(), target_.c_str()) == 0)
+					snapshots_.fetch_add(1, std::memory_order_relaxed);
+			}
+			sleep_interval();
+		}
+	}
+
+	void sleep_interval()
+	{
+		auto until = std::chrono::steady_clock::now() + interval_;
+		while (!stop_.load() && std::chrono::steady_clock::now() < until)
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	void serve(const std::string & path)
+	{
+#if defined(__linux__)
+		sockaddr_un addr{};
+		if (path.size() >= sizeof addr.sun_path)
+			return;
+		addr.sun_family = AF_UNIX;
+		path.copy(addr.sun_path, path.size());
+		// Only a socket is replaced, so a mistyped target cannot delete a file.
+		struct stat st;
+		if (lstat(path.c_str(), &st) == 0 && !S_ISSOCK(st.st_mode))
+			return;
+		int lfd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (lfd < 0)
+			return;
+		unlink(path.c_str());
+		if (bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof addr) < 0 || listen(lfd, 16) < 0)
+		{
+			close(lfd);
+			return;
+		}
+		pollfd pfd{lfd, POLLIN, 0};
+		while (!stop_.load())
+		{
+			if (poll(&pfd, 1, 100) <= 0)
+				continue;
+			int fd = accept4(lfd, nullptr, nullptr, SOCK_CLOEXEC);
+			if (fd < 0)
+				continue;
+			answer(fd);
+			close(fd);
+		}
+		close(lfd);
+		unlink(path.c_str());
+#else
+		(void)path;
+#endif
+	}
+
+#if defined(__linux__)
+	void answer(int fd)
+	{
+		// A client that sends nothing within 50 ms gets the bare text.
+		char req[1024];
+		ssize_t n = 0;
+		pollfd pfd{fd, POLLIN, 0};
+		if (poll(&pfd, 1, 50) > 0)
+			n = recv(fd, req, sizeof req, 0);
+		std::string text = reg_.render();
+		std::string out;
+		if (n >= 4 && std::string(req, 4) == "GET ")
+		{
+			out = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+				std::to_string(text.size()) + "\r\nConnection: close\r\n\r\n";
+		}
+		out += text;
+		const char * p = out.data();
+		std::size_t left = out.size();
+		while (left > 0)
+		{
+			ssize_t w = send(fd, p, left, MSG_NOSIGNAL);
+			if (w <= 0)
+				return;
+			p += w;
+			left -= std::size_t(w);
+		}
+		snapshots_.fetch_add(1, std::memory_order_relaxed);
+	}
+#endif
+
+	const metrics_registry & reg_;
+	std::string target_;
+	std::chrono::milliseconds interval_;
+	std::atomic<bool> stop_{false};
+	std::atomic<std::size_t> snapshots_{0};
+	std::thread thread_;
+};
+
+} // namespace dsa
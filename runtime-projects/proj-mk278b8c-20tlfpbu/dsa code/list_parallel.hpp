@@ -0,0 +1,152 @@
+// Parallel map/filter/reduce over NULL-terminated list chains.
+//
+// The list is cut into balanced segments [first, next segment's first).
+// Boundaries come either from one discovery walk (discover_segments) or
+// from markers the caller already maintains. Each segment runs on the
+// thread pool and filtered segments are stitched back with one link write.
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "list_traits.hpp"
+#include "thread_pool.hpp"
+
+namespace dsa {
+
+// One pass over the list keeping every `stride`-th node. When more than
+// 2*parts marks pile up, every other one is dropped and the stride doubled,
+// so the walk needs no prior length and leaves at most 2*parts segments
+// whose sizes differ by at most one stride.
+template <class N>
+std::vector<N *> discover_segments(N * start, std::size_t parts)
+{
+	std::vector<N *> marks;
+	if (start == nullptr)
+		return marks;
+	if (parts == 0)
+		parts = 1;
+	std::size_t stride = 1, i = 0;
+	for (N * ptr = start; ptr != nullptr; ptr = next_of(ptr), i++)
+	{
+		if (i % stride != 0)
+			continue;
+		marks.push_back(ptr);
+		if (marks.size() > 2 * parts)
+		{
+			std::size_t k = 0;
+			for (std::size_t j = 0; j < marks.size(); j += 2)
+				marks[k++] = marks[j];
+			marks.resize(k);
+			stride *= 2;
+		}
+	}
+	return marks;
+}
+
+// Applies f to every payload in place.
+template <class N, class F>
+void parallel_map(thread_pool & pool, const std::vector<N *> & marks, F f)
+{
+	pool.run_n(marks.size(), [&](std::size_t s) {
+		N * end = s + 1 < marks.size() ? marks[s + 1] : nullptr;
+		for (N * ptr = marks[s]; ptr != end; ptr = next_of(ptr))
+			value_of(ptr) = f(value_of(ptr));
+	});
+}
+
+// Reduces each segment locally, then folds the partials in list order so
+// non-commutative ops still see left-to-right order.
+template <class N, class Acc, class Map, class Op>
+Acc parallel_reduce(thread_pool & pool, const std::vector<N *> & marks, Acc init, Map map, Op op)
+{
+	if (marks.empty())
+		return init;
+	std::vector<Acc> partial(marks.size());
+	pool.run_n(marks.size(), [&](std::size_t s) {
+		N * end = s + 1 < marks.size() ? marks[s + 1] : nullptr;
+		N * ptr = marks[s];
+		Acc acc = map(value_of(ptr));
+		for (ptr = next_of(ptr); ptr != end; ptr = next_of(ptr))
+			acc = op(std::move(acc), map(value_of(ptr)));
+		partial[s] = std::move(acc);
+	});
+	for (std::size_t s = 0; s < marks.size(); s++)
+		init = op(std::move(init), std::move(partial[s]));
+	return init;
+}
+
+// Keeps nodes whose payload satisfies pred, handing the rest to drop(node)
+// (e.g. free for nodes from the C programs). Each segment is relinked
+// independently and the kept sub-chains are spliced in order in O(segments).
+// Returns the new start; `marks` is invalid afterwards.
+template <class N, class P, class D>
+N * parallel_filter(thread_pool & pool, const std::vector<N *> & marks, P pred, D drop)
+{
+	struct piece
+	{
+		N * head;
+		N * tail;
+	};
+	std::vector<piece> out(marks.size(), piece{nullptr, nullptr});
+	pool.run_n(marks.size(), [&](std::size_t s) {
+		N * end = s + 1 < marks.size() ? marks[s + 1] : nullptr;
+		N * head = nullptr, *tail = nullptr;
+		for (N * ptr = marks[s]; ptr != end;)
+		{
+			N * nxt = next_of(ptr);
+			if (pred(value_of(ptr)))
+			{
+				if (tail)
+					next_of(tail) = ptr;
+				else
+					head = ptr;
+				if constexpr (has_prev<N>::value)
+					ptr->prev = tail;
+				tail = ptr;
+			}
+			else
+				drop(ptr);
+			ptr = nxt;
+		}
+		out[s] = piece{head, tail};
+	});
+	N * start = nullptr, *last = nullptr;
+	for (const piece & p : out)
+	{
+		if (p.head == nullptr)
+			continue;
+		if (last)
+		{
+			next_of(last) = p.head;
+			if constexpr (has_prev<N>::value)
+				p.head->prev = last;
+		}
+		else
+			start = p.head;
+		last = p.tail;
+	}
+	if (last)
+		next_of(last) = nullptr;
+	return start;
+}
+
+// Convenience overloads that discover segments for the pool size first.
+template <class N, class F>
+void parallel_map(thread_pool & pool, N * start, F f)
+{
+	parallel_map(pool, discover_segments(start, pool.size()), std::move(f));
+}
+
+template <class N, class Acc, class Map, class Op>
+Acc parallel_reduce(thread_pool & pool, N * start, Acc init, Map map, Op op)
+{
+	return parallel_reduce(pool, discover_segments(start, pool.size()), std::move(init), std::move(map), std::move(op));
+}
+
+template <class N, class P, class D>
+N * parallel_filter(thread_pool & pool, N * start, P pred, D drop)
+{
+	return parallel_filter(pool, discover_segments(start, pool.size()), std::move(pred), std::move(drop));
+}
+
+} // namespace dsa
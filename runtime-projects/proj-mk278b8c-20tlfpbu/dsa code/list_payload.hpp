@@ -0,0 +1,248 @@
+// Payload types that live inside the list node instead of behind a pointer.
+//
+// inline_string<N>: bounded string stored in the node itself, so
+//   dsa::sll<dsa::inline_string<24>> is one allocation per element.
+// flex_sll: variable-length records in a trailing array sized at allocation,
+//   so link, length and bytes share one block (and usually one cache line).
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include "list_traits.hpp"
+
+namespace dsa {
+
+template <std::size_t N>
+class inline_string
+{
+	static_assert(N > 0 && N < 256, "inline_string keeps its length in one byte");
+
+public:
+	inline_string() = default;
+	inline_string(std::string_view s) { assign(s); }
+	inline_string(const char * s) { assign(s ? std::string_view(s) : std::string_view()); } // nullptr: empty
+	inline_string(std::size_t count, char c)
+	{
+		if (count > N)
+			throw std::length_error("inline_string: payload too long");
+		std::memset(buf_, c, count);
+		len_ = std::uint8_t(count);
+	}
+
+	void assign(std::string_view s)
+	{
+		if (s.size() > N)
+			throw std::length_error("inline_string: payload too long");
+		if (!s.empty())
+			std::memcpy(buf_, s.data(), s.size());
+		len_ = std::uint8_t(s.size());
+	}
+
+	static constexpr std::size_t capacity() { return N; }
+	std::size_t size() const { return len_; }
+	const char * data() const { return buf_; }
+	std::string_view view() const { return std::string_view(buf_, len_); }
+	operator std::string_view() const { return view(); }
+
+	friend bool operator==(const inline_string & a, const inline_string & b) { return a.view() == b.view(); }
+	friend bool operator!=(const inline_string & a, const inline_string & b) { return a.view() != b.view(); }
+	friend bool operator<(const inline_string & a, const inline_string & b) { return a.view() < b.view(); }
+
+private:
+	std::uint8_t len_ = 0;
+	char buf_[N];
+};
+
+// Node with its payload bytes directly after the header.
+struct flex_node
+{
+	flex_node * link;
+	std::uint32_t size;
+
+	char * bytes() { return reinterpret_cast<char *>(this + 1); }
+	const char * bytes() const { return reinterpret_cast<const char *>(this + 1); }
+	std::string_view view() const { return std::string_view(bytes(), size); }
+};
+
+// Singly linked list of variable-length records, one allocation per node
+// from a pmr resource. Provides these dsa::sll ops under the same names:
+// insert_beg, insert_end, delete_beg, delete_end, search, reverse,
+// for_each, clear, abandon, move construction and assignment. There is no
+// emplace, sort or splice_end.
+class flex_sll
+{
+public:
+	using node = flex_node;
+
+	explicit flex_sll(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : mr_(mr) {}
+	~flex_sll() { clear(); }
+
+	flex_sll(flex_sll && o) noexcept : mr_(o.mr_), start_(o.start_), tail_(o.tail_), len_(o.len_)
+	{
+		o.start_ = o.tail_ = nullptr;
+		o.len_ = 0;
+	}
+	flex_sll & operator=(flex_sll && o) noexcept
+	{
+		if (this != &o)
+		{
+			clear();
+			mr_ = o.mr_;
+			start_ = o.start_;
+			tail_ = o.tail_;
+			len_ = o.len_;
+			o.start_ = o.tail_ = nullptr;
+			o.len_ = 0;
+		}
+		return *this;
+	}
+	flex_sll(const flex_sll &) = delete;
+	flex_sll & operator=(const flex_sll &) = delete;
+
+	node * head() const { return start_; }
+	node * tail() const { return tail_; }
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+	std::pmr::memory_resource * resource() const { return mr_; }
+
+	list_status insert_beg(std::string_view item)
+	{
+		node * n = make(item);
+		if (n == nullptr)
+			return list_status::overflow;
+		n->link = start_;
+		start_ = n;
+		if (tail_ == nullptr)
+			tail_ = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status insert_end(std::string_view item)
+	{
+		node * n = make(item);
+		if (n == nullptr)
+			return list_status::overflow;
+		if (tail_)
+			tail_->link = n;
+		else
+			start_ = n;
+		tail_ = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status delete_beg()
+	{
+		if (start_ == nullptr)
+			return list_status::underflow;
+		node * ptr = start_;
+		start_ = ptr->link;
+		if (start_ == nullptr)
+			tail_ = nullptr;
+		drop(ptr);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_end()
+	{
+		if (start_ == nullptr)
+			return list_status::underflow;
+		if (start_ == tail_)
+			return delete_beg();
+		node * prev = start_;
+		while (prev->link != tail_)
+			prev = prev->link;
+		drop(tail_);
+		prev->link = nullptr;
+		tail_ = prev;
+		len_--;
+		return list_status::ok;
+	}
+
+	std::size_t search(std::string_view item) const
+	{
+		std::size_t loc = 1;
+		for (node * ptr = start_; ptr != nullptr; ptr = ptr->link, loc++)
+			if (ptr->view() == item)
+				return loc;
+		return 0;
+	}
+
+	void reverse()
+	{
+		node * ptr = start_, *prev = nullptr;
+		tail_ = start_;
+		while (ptr != nullptr)
+		{
+			node * temp = ptr->link;
+			ptr->link = prev;
+			prev = ptr;
+			ptr = temp;
+		}
+		start_ = prev;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (node * ptr = start_; ptr != nullptr; ptr = ptr->link)
+			f(ptr->view());
+	}
+
+	void clear()
+	{
+		node * ptr = start_;
+		while (ptr != nullptr)
+		{
+			node * temp = ptr->link;
+			drop(ptr);
+			ptr = temp;
+		}
+		start_ = tail_ = nullptr;
+		len_ = 0;
+	}
+
+	// See sll::abandon(); payload bytes are trivially destructible.
+	void abandon()
+	{
+		start_ = tail_ = nullptr;
+		len_ = 0;
+	}
+
+private:
+	static std::size_t bytes_for(std::size_t n) { return sizeof(node) + n; }
+
+	node * make(std::string_view item)
+	{
+		if (item.size() > UINT32_MAX)
+			return nullptr;
+		void * p;
+		try
+		{
+			p = mr_->allocate(bytes_for(item.size()), alignof(node));
+		}
+		catch (const std::bad_alloc &)
+		{
+			return nullptr;
+		}
+		node * n = ::new (p) node{nullptr, std::uint32_t(item.size())};
+		if (!item.empty())
+			std::memcpy(n->bytes(), item.data(), item.size());
+		return n;
+	}
+
+	void drop(node * n) { mr_->deallocate(n, bytes_for(n->size), alignof(node)); }
+
+	std::pmr::memory_resource * mr_;
+	node * start_ = nullptr;
+	node * tail_ = nullptr;
+	std::size_t len_ = 0;
+};
+
+} // namespace dsa
@@ -0,0 +1,179 @@
+// Lazy map/filter/take pipelines over any list shape.
+//
+//   long s = dsa::from_list(start)
+//                .filter([](int x) { return x > 0; })
+//                .map([](int x) { return (long)x * x; })
+//                .reduce(0L, std::plus<>());
+//
+// Stages only record what to do. The terminal op (reduce, for_each,
+// collect) nests every stage into one sink type at compile time and the
+// list is walked once, with no intermediate list or insert_end calls.
+#pragma once
+#include <cstddef>
+#include <utility>
+#include "list_traits.hpp"
+
+namespace dsa {
+
+namespace pipe_detail {
+
+// Sinks take one value and return false to stop the walk.
+template <class F, class Down>
+struct map_sink
+{
+	F f;
+	Down down;
+	template <class V>
+	bool operator()(V && v) { return down(f(std::forward<V>(v))); }
+};
+
+template <class P, class Down>
+struct filter_sink
+{
+	P pred;
+	Down down;
+	template <class V>
+	bool operator()(V && v)
+	{
+		if (!pred(v))
+			return true;
+		return down(std::forward<V>(v));
+	}
+};
+
+template <class Down>
+struct take_sink
+{
+	std::size_t left;
+	Down down;
+	template <class V>
+	bool operator()(V && v)
+	{
+		if (left == 0)
+			return false;
+		--left;
+		return down(std::forward<V>(v)) && left != 0;
+	}
+};
+
+// Stages wrap a downstream sink into an upstream one.
+struct identity_stage
+{
+	template <class S>
+	S wrap(S s) const { return s; }
+};
+
+template <class F>
+struct map_stage
+{
+	F f;
+	template <class S>
+	map_sink<F, S> wrap(S s) const { return {f, std::move(s)}; }
+};
+
+template <class P>
+struct filter_stage
+{
+	P pred;
+	template <class S>
+	filter_sink<P, S> wrap(S s) const { return {pred, std::move(s)}; }
+};
+
+struct take_stage
+{
+	std::size_t n;
+	template <class S>
+	take_sink<S> wrap(S s) const { return {n, std::move(s)}; }
+};
+
+template <class Up, class Next>
+struct then_stage
+{
+	Up up;
+	Next next;
+	template <class S>
+	auto wrap(S s) const { return up.wrap(next.wrap(std::move(s))); }
+};
+
+} // namespace pipe_detail
+
+template <walk W, class N, class Stage = pipe_detail::identity_stage>
+class pipeline
+{
+public:
+	pipeline(N * start, Stage stage = Stage()) : start_(start), stage_(std::move(stage)) {}
+
+	template <class F>
+	auto map(F f) const { return chain(pipe_detail::map_stage<F>{std::move(f)}); }
+
+	template <class P>
+	auto filter(P pred) const { return chain(pipe_detail::filter_stage<P>{std::move(pred)}); }
+
+	auto take(std::size_t n) const { return chain(pipe_detail::take_stage{n}); }
+
+	// Feeds every surviving value to `sink`; the sink returns false to stop.
+	template <class S>
+	void run(S sink) const
+	{
+		auto fused = stage_.wrap(std::move(sink));
+		walk_nodes<W>(start_, [&fused](N * p) { return fused(value_of(p)); });
+	}
+
+	template <class Acc, class Op>
+	Acc reduce(Acc init, Op op) const
+	{
+		Acc * acc = &init;
+		run([acc, &op](auto && v) {
+			*acc = op(std::move(*acc), std::forward<decltype(v)>(v));
+			return true;
+		});
+		return init;
+	}
+
+	template <class F>
+	void for_each(F f) const
+	{
+		run([&f](auto && v) {
+			f(std::forward<decltype(v)>(v));
+			return true;
+		});
+	}
+
+	// Writes results through an output iterator, e.g. std::back_inserter.
+	template <class Out>
+	Out collect(Out out) const
+	{
+		run([&out](auto && v) {
+			*out = std::forward<decltype(v)>(v);
+			++out;
+			return true;
+		});
+		return out;
+	}
+
+	std::size_t count() const
+	{
+		return reduce(std::size_t(0), [](std::size_t c, auto &&) { return c + 1; });
+	}
+
+private:
+	template <class Next>
+	auto chain(Next next) const
+	{
+		using then = pipe_detail::then_stage<Stage, Next>;
+		return pipeline<W, N, then>(start_, then{stage_, std::move(next)});
+	}
+
+	N * start_;
+	Stage stage_;
+};
+
+// NULL-terminated lists: SLL, DLL, stack top, queue front.
+template <class N>
+pipeline<walk::linear, N> from_list(N * start) { return pipeline<walk::linear, N>(start); }
+
+// Circular lists (csll.c, CDLL.c): stops on returning to start.
+template <class N>
+pipeline<walk::circular, N> from_ring(N * start) { return pipeline<walk::circular, N>(start); }
+
+} // namespace dsa
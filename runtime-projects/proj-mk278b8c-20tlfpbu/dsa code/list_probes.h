@@ -0,0 +1,105 @@
+#ifndef LIST_PROBES_H
+#define LIST_PROBES_H
+//USDT (user-level statically defined tracing) probes, provider dsa_list,
+//for observing running binaries with bpftrace or perf without rebuilding:
+//    bpftrace -l 'usdt:./menu_linked:dsa_list:*'
+//    bpftrace -e 'usdt:./menu_linked:dsa_list:long_walk { @[arg2]=hist(arg1); }'
+//    perf buildid-cache --add ./list_server; perf probe sdt_dsa_list:pool_refill
+//A probe site is a single nop plus an ELF note naming it, its provider and
+//where its arguments live; a tracer patches the nop only while attached.
+//The arguments are values the op already has in hand (list id, length,
+//item), so a site costs the nop and nothing else when no one is tracing.
+//With <sys/sdt.h> (systemtap-sdt-dev) the probes come from there. Without
+//it, on x86-64 and aarch64 with GCC or Clang, this header writes the same
+//.note.stapsdt records itself; elsewhere, or with -DLIST_NO_PROBES, every
+//site compiles to nothing. Every argument is passed as a signed 64-bit
+//integer either way.
+//Probe conventions, used by the C programs and the dsa engine alike:
+//    <op>_entry     (list, length, arg)     arg: item, or 0 if none yet
+//    <op>_return    (list, length, result)  result: item, location or status
+//    long_walk      (list, steps, op)       a walk of LIST_LONG_WALK+ links
+//<op> names the operation, not the function (searching_sll and the engine's
+//search() both fire search_*), so one script covers every list. steps
+//counts the links the walk followed.
+//The list id is the address of the list's ListStats in the C programs,
+//and of the list object in the engine. Slow paths carry their own:
+//    pool_refill     (pool, chunks, live nodes)   node_pool.hpp
+//    pool_trim       (pool, chunks)               node_pool.hpp
+//    queue_contended (thread pool)                thread_pool.hpp
+//    retire_flush    (nodes)                      retire.h
+//    retire_contended(nodes)                      retire.h, RETIRE_THREAD
+//    output_stall    (buffers in flight)          display.h, DISPLAY_ASYNC
+#define LIST_LONG_WALK 1024
+//Op codes for long_walk, so one probe serves every walking op.
+enum list_walk_op{
+    LIST_WALK_INSERT_END=1,
+    LIST_WALK_DELETE_END=2,
+    LIST_WALK_SEARCH=3,
+    LIST_WALK_INSERT_LOC=4
+};
+#if !defined(LIST_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define LIST_PROBES_SDT 1
+#elif defined(__linux__) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+#define LIST_PROBES_NOTES 1
+#endif
+#endif
+#define LIST_PROBE_ARG(x) ((long long)(x))
+#if defined(LIST_PROBES_SDT)
+#include<sys/sdt.h>
+#define LIST_PROBE1(name,a) STAP_PROBE1(dsa_list,name,LIST_PROBE_ARG(a))
+#define LIST_PROBE2(name,a,b) STAP_PROBE2(dsa_list,name,LIST_PROBE_ARG(a),LIST_PROBE_ARG(b))
+#define LIST_PROBE3(name,a,b,c) STAP_PROBE3(dsa_list,name,LIST_PROBE_ARG(a),LIST_PROBE_ARG(b),LIST_PROBE_ARG(c))
+#elif defined(LIST_PROBES_NOTES)
+//The stapsdt note layout (version 3) as sys/sdt.h writes it: probe pc,
+//the .stapsdt.base address (lets tracers undo prelink), a semaphore
+//address (0, none used), then provider, name and "size@operand" per arg.
+#if defined(__x86_64__)
+#define LIST_PROBE_OPND "nor"
+#else
+#define LIST_PROBE_OPND "r"
+#endif
+#define LIST_PROBE_ASM(name,args) \
+    "990: nop\n" \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n" \
+    ".balign 4\n" \
+    ".4byte 992f-991f,994f-993f,3\n" \
+    "991: .asciz \"stapsdt\"\n" \
+    "992: .balign 4\n" \
+    "993: .8byte 990b\n" \
+    ".8byte _.stapsdt.base\n" \
+    ".8byte 0\n" \
+    ".asciz \"dsa_list\"\n" \
+    ".asciz \"" #name "\"\n" \
+    ".asciz \"" args "\"\n" \
+    "994: .balign 4\n" \
+    ".popsection\n" \
+    ".ifndef _.stapsdt.base\n" \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+    ".weak _.stapsdt.base\n" \
+    ".hidden _.stapsdt.base\n" \
+    "_.stapsdt.base: .space 1\n" \
+    ".size _.stapsdt.base,1\n" \
+    ".popsection\n" \
+    ".endif\n"
+#define LIST_PROBE1(name,a) \
+    __asm__ __volatile__(LIST_PROBE_ASM(name,"-8@%0") \
+        : : LIST_PROBE_OPND(LIST_PROBE_ARG(a)))
+#define LIST_PROBE2(name,a,b) \
+    __asm__ __volatile__(LIST_PROBE_ASM(name,"-8@%0 -8@%1") \
+        : : LIST_PROBE_OPND(LIST_PROBE_ARG(a)),LIST_PROBE_OPND(LIST_PROBE_ARG(b)))
+#define LIST_PROBE3(name,a,b,c) \
+    __asm__ __volatile__(LIST_PROBE_ASM(name,"-8@%0 -8@%1 -8@%2") \
+        : : LIST_PROBE_OPND(LIST_PROBE_ARG(a)),LIST_PROBE_OPND(LIST_PROBE_ARG(b)),LIST_PROBE_OPND(LIST_PROBE_ARG(c)))
+#else
+#define LIST_PROBE1(name,a) ((void)(a))
+#define LIST_PROBE2(name,a,b) ((void)(a),(void)(b))
+#define LIST_PROBE3(name,a,b,c) ((void)(a),(void)(b),(void)(c))
+#endif
+//Fires long_walk when a walk covered at least LIST_LONG_WALK nodes.
+#define LIST_PROBE_WALK(list,steps,op) \
+    do{ \
+        if((steps)>=LIST_LONG_WALK) \
+            LIST_PROBE3(long_walk,list,steps,op); \
+    }while(0)
+#endif
@@ -0,0 +1,66 @@
+#ifndef LIST_PROTOCOL_H
+#define LIST_PROTOCOL_H
+#include<stdint.h>
+//Wire format of list_server, a Unix domain socket service holding named
+//SLL/DLL/stack/queue lists (see list_server.cpp, list_loadgen.cpp).
+//Both directions carry frames: an 8-byte lp_frame header and `count`
+//16-byte records. A request frame holds lp_op records, and its response
+//holds one lp_result per op, in order, under the same seq. Clients may
+//send more frames without waiting for earlier responses (pipelining).
+//Integers are in host byte order: both ends are on the same machine.
+#define LP_DEFAULT_PATH "/tmp/list_server.sock"
+#define LP_MAX_BATCH 4096
+struct lp_frame{
+    uint32_t count;
+    uint32_t seq;
+};
+//A list id is bound to a kind by LP_CREATE and freed by LP_DROP.
+enum lp_kind{
+    LP_SLL=1,
+    LP_DLL=2,
+    LP_STACK=3,
+    LP_QUEUE=4
+};
+//Op names follow the C programs. Which ops a kind takes:
+//  SLL, DLL  insert_beg, insert_end, delete_beg, delete_end, search
+//  stack     push, pop, peek
+//  queue     enqueue, dequeue, front
+//  all       create, drop, length, clear
+enum lp_opcode{
+    LP_CREATE=1,     //arg: lp_kind
+    LP_DROP,
+    LP_LENGTH,       //value: length
+    LP_CLEAR,
+    LP_INSERT_BEG,   //arg: item
+    LP_INSERT_END,   //arg: item
+    LP_DELETE_BEG,   //value: deleted item
+    LP_DELETE_END,   //value: deleted item
+    LP_SEARCH,       //arg: item; value: 1-based location, 0 if absent
+    LP_PUSH,         //arg: item
+    LP_POP,          //value: popped item
+    LP_PEEK,         //value: top item
+    LP_ENQUEUE,      //arg: item
+    LP_DEQUEUE,      //value: dequeued item
+    LP_FRONT         //value: front item
+};
+//LP_OK..LP_NOT_FOUND match dsa::list_status.
+enum lp_status{
+    LP_OK=0,
+    LP_OVERFLOW=1,
+    LP_UNDERFLOW=2,
+    LP_NOT_FOUND=3,
+    LP_NO_LIST=4,    //id not created, or created twice
+    LP_BAD_OP=5      //op unknown or not valid for the list's kind
+};
+struct lp_op{
+    uint8_t op;
+    uint8_t pad[3];
+    uint32_t list;
+    int64_t arg;
+};
+struct lp_result{
+    uint8_t status;
+    uint8_t pad[7];
+    int64_t value;
+};
+#endif
@@ -0,0 +1,585 @@
+// Local list service: named SLL/DLL/stack/queue lists behind a Unix domain
+// socket, driven with the batched binary protocol of list_protocol.h.
+//
+//   g++ -std=c++17 -O2 list_server.cpp -o list_server
+//   ./list_server [socket path] [metrics target]   // default /tmp/list_server.sock
+//   ./list_loadgen -c 4 -b 64 -d 8                 // see list_loadgen.cpp
+//
+// One thread runs a level-triggered epoll loop over non-blocking sockets.
+// Each connection keeps an input buffer of unparsed bytes and an output
+// buffer of unsent replies. Every complete frame that a read brings in is
+// executed in order, and all of its replies go out with one send. A
+// connection whose client stops reading is not read from until its backlog
+// drains. Lists are dsa engine lists over one node_pool, shared by every
+// connection.
+//
+// With a metrics target ("unix:/path" or a file, see list_metrics.hpp) the
+// server also exports op counts, length, errors and op latency for every
+// list, labelled with its id and kind, plus the node pool's occupancy. A
+// list's metrics are registered when it is created and removed when it is
+// dropped. Op timing is only done with a target.
+// Built with -DDSA_TRACE, LIST_TRACE=out.json[:N] records a timeline of
+// frames, list ops and pool refills (list_trace.hpp), dumped on SIGINT.
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "list_engine.hpp"
+#include "list_metrics.hpp"
+#include "list_protocol.h"
+#include "node_pool.hpp"
+
+namespace {
+
+using item_t = std::int64_t;
+using list_variant = std::variant<dsa::sll<item_t>, dsa::dll<item_t>, dsa::stack<item_t>, dsa::queue<item_t>>;
+
+// A served list and, when metrics are exported, its own counters, which
+// stay registered for as long as the list exists.
+struct list_entry
+{
+	list_variant list;
+	std::unique_ptr<dsa::list_metrics> metrics;
+	dsa::metrics_registry * reg = nullptr;
+
+	list_entry() = default;
+	list_entry(const list_entry &) = delete;
+	list_entry & operator=(const list_entry &) = delete;
+	~list_entry()
+	{
+		if (metrics)
+			reg->remove(*metrics);
+	}
+};
+
+// Stop reading from a connection with this many reply bytes unsent.
+constexpr std::size_t max_backlog = std::size_t(16) << 20;
+// Bytes read from one connection before its frames are parsed.
+constexpr std::size_t max_input = std::size_t(1) << 20;
+
+volatile std::sig_atomic_t stopping = 0;
+
+void on_signal(int) { stopping = 1; }
+
+// Runs f on the list when it holds an L; false otherwise.
+template <class L, class F>
+bool with(list_variant & v, F && f)
+{
+	if (L * l = std::get_if<L>(&v))
+	{
+		f(*l);
+		return true;
+	}
+	return false;
+}
+
+class list_service
+{
+public:
+	list_service() : pool_(sizeof(dsa::dll_node<item_t>), alignof(dsa::dll_node<item_t>)) {}
+
+	// Lists created from now on register their metrics with reg. reg must
+	// outlive the service.
+	void attach(dsa::metrics_registry * reg, dsa::pool_metrics * pool)
+	{
+		reg_ = reg;
+		pool_m_ = pool;
+	}
+
+	void publish()
+	{
+		if (pool_m_)
+			pool_m_->publish(pool_);
+	}
+
+	lp_result execute(const lp_op & op)
+	{
+		lp_result r{};
+		if (op.op == LP_CREATE)
+		{
+			r.status = create(op.list, op.arg);
+			return r;
+		}
+		auto it = lists_.find(op.list);
+		if (it == lists_.end())
+		{
+			r.status = LP_NO_LIST;
+			return r;
+		}
+		list_entry & e = *it->second;
+		if (!e.metrics || op.op == LP_DROP) // a dropped list takes its metrics with it
+			return apply(op, it);
+		dsa::list_metrics & m = *e.metrics;
+		{
+			dsa::latency_histogram::timer t(m.latency());
+			r = apply(op, it);
+		}
+		m.count(metric_of(op.op));
+		if (r.status != LP_OK)
+			m.count_error();
+		m.set_length(length_of(e.list));
+		return r;
+	}
+
+private:
+	using list_map = std::unordered_map<std::uint32_t, std::unique_ptr<list_entry>>;
+
+	static std::size_t length_of(const list_variant & v)
+	{
+		return std::visit([](const auto & l) { return l.length(); }, v);
+	}
+
+	static dsa::metric_op metric_of(std::uint8_t op)
+	{
+		switch (op)
+		{
+		case LP_INSERT_BEG:
+		case LP_PUSH:
+			return dsa::metric_op::insert_beg;
+		case LP_INSERT_END:
+		case LP_ENQUEUE:
+			return dsa::metric_op::insert_end;
+		case LP_DELETE_BEG:
+		case LP_POP:
+		case LP_DEQUEUE:
+			return dsa::metric_op::delete_beg;
+		case LP_DELETE_END:
+			return dsa::metric_op::delete_end;
+		case LP_SEARCH:
+			return dsa::metric_op::search;
+		default:
+			return dsa::metric_op::other;
+		}
+	}
+
+	lp_result apply(const lp_op & op, list_map::iterator it)
+	{
+		lp_result r{};
+		list_variant & v = it->second->list;
+		dsa::list_status st = dsa::list_status::ok;
+		item_t out = 0;
+		bool valid = true;
+		auto insert_beg = [&](auto & l) { st = l.insert_beg(op.arg); };
+		auto insert_end = [&](auto & l) { st = l.insert_end(op.arg); };
+		auto delete_beg = [&](auto & l) { st = l.delete_beg(&out); };
+		auto delete_end = [&](auto & l) { st = l.delete_end(&out); };
+		auto search = [&](auto & l) { out = item_t(l.search(op.arg)); };
+		switch (op.op)
+		{
+		case LP_DROP:
+			lists_.erase(it);
+			return r;
+		case LP_LENGTH:
+			std::visit([&](auto & l) { out = item_t(l.length()); }, v);
+			break;
+		case LP_CLEAR:
+			std::visit([](auto & l) { l.clear(); }, v);
+			break;
+		case LP_INSERT_BEG:
+			valid = with<dsa::sll<item_t>>(v, insert_beg) || with<dsa::dll<item_t>>(v, insert_beg);
+			break;
+		case LP_INSERT_END:
+			valid = with<dsa::sll<item_t>>(v, insert_end) || with<dsa::dll<item_t>>(v, insert_end);
+			break;
+		case LP_DELETE_BEG:
+			valid = with<dsa::sll<item_t>>(v, delete_beg) || with<dsa::dll<item_t>>(v, delete_beg);
+			break;
+		case LP_DELETE_END:
+			valid = with<dsa::sll<item_t>>(v, delete_end) || with<dsa::dll<item_t>>(v, delete_end);
+			break;
+		case LP_SEARCH:
+			valid = with<dsa::sll<item_t>>(v, search) || with<dsa::dll<item_t>>(v, search);
+			break;
+		case LP_PUSH:
+			valid = with<dsa::stack<item_t>>(v, [&](auto & l) { st = l.push(op.arg); });
+			break;
+		case LP_POP:
+			valid = with<dsa::stack<item_t>>(v, [&](auto & l) { st = l.pop(&out); });
+			break;
+		case LP_PEEK:
+			valid = with<dsa::stack<item_t>>(v, [&](auto & l) {
+				if (const item_t * top = l.peek())
+					out = *top;
+				else
+					st = dsa::list_status::underflow;
+			});
+			break;
+		case LP_ENQUEUE:
+			valid = with<dsa::queue<item_t>>(v, [&](auto & l) { st = l.enqueue(op.arg); });
+			break;
+		case LP_DEQUEUE:
+			valid = with<dsa::queue<item_t>>(v, [&](auto & l) { st = l.dequeue(&out); });
+			break;
+		case LP_FRONT:
+			valid = with<dsa::queue<item_t>>(v, [&](auto & l) {
+				if (l.front())
+					out = l.front()->info;
+				else
+					st = dsa::list_status::underflow;
+			});
+			break;
+		default:
+			valid = false;
+		}
+		r.status = valid ? std::uint8_t(st) : std::uint8_t(LP_BAD_OP);
+		r.value = out;
+		return r;
+	}
+
+	std::uint8_t create(std::uint32_t id, item_t kind)
+	{
+		if (lists_.count(id))
+			return LP_NO_LIST;
+		auto l = std::make_unique<list_entry>();
+		const char * kind_name;
+		switch (kind)
+		{
+		case LP_SLL:
+			l->list.emplace<dsa::sll<item_t>>(&pool_);
+			kind_name = "sll";
+			break;
+		case LP_DLL:
+			l->list.emplace<dsa::dll<item_t>>(&pool_);
+			kind_name = "dll";
+			break;
+		case LP_STACK:
+			l->list.emplace<dsa::stack<item_t>>(&pool_);
+			kind_name = "stack";
+			break;
+		case LP_QUEUE:
+			l->list.emplace<dsa::queue<item_t>>(&pool_);
+			kind_name = "queue";
+			break;
+		default:
+			return LP_BAD_OP;
+		}
+		if (reg_)
+		{
+			l->metrics = std::make_unique<dsa::list_metrics>(std::to_string(id), kind_name);
+			l->reg = reg_;
+			reg_->add(*l->metrics);
+		}
+		lists_.emplace(id, std::move(l));
+		return LP_OK;
+	}
+
+	// Declared first so it outlives the lists allocating from it.
+	dsa::node_pool pool_;
+	list_map lists_;
+	dsa::metrics_registry * reg_ = nullptr;
+	dsa::pool_metrics * pool_m_ = nullptr;
+};
+
+struct connection
+{
+	int fd;
+	std::vector<char> in;  // bytes of frames not complete yet
+	std::size_t in_len = 0;
+	std::vector<char> out; // replies not sent yet
+	std::size_t out_sent = 0;
+	std::uint32_t events = 0;
+};
+
+class server
+{
+public:
+	server(int listen_fd, int epoll_fd) : listen_fd_(listen_fd), epoll_fd_(epoll_fd) {}
+
+	list_service & service() { return service_; }
+
+	void run()
+	{
+		epoll_event ev[256];
+		while (!stopping)
+		{
+			int n = epoll_wait(epoll_fd_, ev, 256, -1);
+			if (n < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				std::perror("epoll_wait");
+				return;
+			}
+			for (int i = 0; i < n; i++)
+			{
+				if (ev[i].data.ptr == nullptr)
+				{
+					accept_all();
+					continue;
+				}
+				connection * c = static_cast<connection *>(ev[i].data.ptr);
+				bool alive = true;
+				if (ev[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+					alive = on_readable(c);
+				if (alive && (ev[i].events & EPOLLOUT))
+					alive = flush(c);
+				if (alive)
+					alive = rearm(c);
+				if (!alive)
+					drop(c);
+			}
+			service_.publish();
+		}
+	}
+
+private:
+	void accept_all()
+	{
+		for (;;)
+		{
+			int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+			if (fd < 0)
+				return;
+			auto c = std::make_unique<connection>();
+			c->fd = fd;
+			c->in.resize(64 * 1024);
+			c->events = EPOLLIN;
+			epoll_event ev{};
+			ev.events = c->events;
+			ev.data.ptr = c.get();
+			if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+			{
+				close(fd);
+				continue;
+			}
+			conns_.emplace(c.get(), std::move(c));
+		}
+	}
+
+	// Reads what is there, answers every complete frame, sends the replies.
+	bool on_readable(connection * c)
+	{
+		for (;;)
+		{
+			if (c->in_len == c->in.size())
+			{
+				if (c->in.size() >= max_input)
+					break; // parse this much; level-triggered epoll calls again
+				c->in.resize(c->in.size() * 2);
+			}
+			std::size_t space = c->in.size() - c->in_len;
+			ssize_t r = recv(c->fd, c->in.data() + c->in_len, space, 0);
+			if (r == 0)
+				return false;
+			if (r < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+					break;
+				return false;
+			}
+			c->in_len += std::size_t(r);
+			if (std::size_t(r) < space)
+				break; // short read: nothing more queued
+		}
+		std::size_t pos = 0;
+		while (c->in_len - pos >= sizeof(lp_frame))
+		{
+			lp_frame f;
+			std::memcpy(&f, c->in.data() + pos, sizeof f);
+			if (f.count > LP_MAX_BATCH)
+				return false;
+			std::size_t need = sizeof f + std::size_t(f.count) * sizeof(lp_op);
+			if (c->in_len - pos < need)
+				break;
+			answer(c, f, c->in.data() + pos + sizeof f);
+			pos += need;
+		}
+		if (pos > 0)
+		{
+			std::memmove(c->in.data(), c->in.data() + pos, c->in_len - pos);
+			c->in_len -= pos;
+		}
+		return flush(c);
+	}
+
+	void answer(connection * c, const lp_frame & f, const char * ops)
+	{
+		DSA_TRACE_SCOPE_ARG("frame", "server", std::int64_t(f.count));
+		std::size_t at = c->out.size();
+		c->out.resize(at + sizeof f + std::size_t(f.count) * sizeof(lp_result));
+		char * p = c->out.data() + at;
+		std::memcpy(p, &f, sizeof f);
+		p += sizeof f;
+		for (std::uint32_t i = 0; i < f.count; i++)
+		{
+			lp_op op;
+			std::memcpy(&op, ops + std::size_t(i) * sizeof op, sizeof op);
+			lp_result r = service_.execute(op);
+			std::memcpy(p + std::size_t(i) * sizeof r, &r, sizeof r);
+		}
+	}
+
+	bool flush(connection * c)
+	{
+		while (c->out_sent < c->out.size())
+		{
+			ssize_t w = send(c->fd, c->out.data() + c->out_sent, c->out.size() - c->out_sent, MSG_NOSIGNAL);
+			if (w < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+					return true;
+				return false;
+			}
+			c->out_sent += std::size_t(w);
+		}
+		c->out.clear();
+		c->out_sent = 0;
+		return true;
+	}
+
+	// Watches for writability only while replies are queued, and for
+	// input only while the backlog is small.
+	bool rearm(connection * c)
+	{
+		std::size_t backlog = c->out.size() - c->out_sent;
+		std::uint32_t want = (backlog ? std::uint32_t(EPOLLOUT) : 0u) | (backlog < max_backlog ? std::uint32_t(EPOLLIN) : 0u);
+		if (want == c->events)
+			return true;
+		epoll_event ev{};
+		ev.events = want;
+		ev.data.ptr = c;
+		c->events = want;
+		return epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, c->fd, &ev) == 0;
+	}
+
+	void drop(connection * c)
+	{
+		epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, c->fd, nullptr);
+		close(c->fd);
+		conns_.erase(c);
+	}
+
+	int listen_fd_;
+	int epoll_fd_;
+	list_service service_;
+	std::unordered_map<connection *, std::unique_ptr<connection>> conns_;
+};
+
+// Clears the way for bind(): a socket left behind by a server that is gone
+// is removed. Returns why not when something else is at the path, or a
+// server still answers there; nothing is removed then.
+const char * claim_path(const sockaddr_un & addr)
+{
+	struct stat st;
+	if (lstat(addr.sun_path, &st) < 0)
+		return errno == ENOENT ? nullptr : std::strerror(errno);
+	if (!S_ISSOCK(st.st_mode))
+		return "exists and is not a socket";
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return std::strerror(errno);
+	bool live = connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) == 0;
+	close(fd);
+	if (live)
+		return "a server is already listening there";
+	return unlink(addr.sun_path) == 0 ? nullptr : std::strerror(errno);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+	const char * path = argc > 1 ? argv[1] : LP_DEFAULT_PATH;
+	sockaddr_un addr{};
+	if (std::strlen(path) >= sizeof addr.sun_path)
+	{
+		std::fprintf(stderr, "socket path too long\n");
+		return 1;
+	}
+	addr.sun_family = AF_UNIX;
+	std::strcpy(addr.sun_path, path);
+
+	int lfd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (lfd < 0)
+	{
+		std::perror("socket");
+		return 1;
+	}
+	if (const char * why = claim_path(addr))
+	{
+		std::fprintf(stderr, "%s: %s\n", path, why);
+		return 1;
+	}
+	if (bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof addr) < 0 || listen(lfd, 128) < 0)
+	{
+		std::perror(path);
+		return 1;
+	}
+	int efd = epoll_create1(EPOLL_CLOEXEC);
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.ptr = nullptr; // the listening socket
+	if (efd < 0 || epoll_ctl(efd, EPOLL_CTL_ADD, lfd, &ev) < 0)
+	{
+		std::perror("epoll");
+		return 1;
+	}
+
+	struct sigaction sa{};
+	sa.sa_handler = on_signal;
+	sigaction(SIGINT, &sa, nullptr);
+	sigaction(SIGTERM, &sa, nullptr);
+
+	// Declared before the server: its lists unregister from reg as they go.
+	dsa::metrics_registry reg;
+	dsa::pool_metrics pool_m("nodes");
+	server srv(lfd, efd);
+	std::unique_ptr<dsa::metrics_exporter> exporter;
+	if (argc > 2)
+	{
+		reg.add(pool_m);
+		srv.service().attach(&reg, &pool_m);
+		exporter = std::make_unique<dsa::metrics_exporter>(reg, argv[2]);
+	}
+
+#if defined(DSA_TRACE)
+	// LIST_TRACE=file.json[:N] records one frame in N and dumps on exit.
+	const char * trace_to = std::getenv("LIST_TRACE");
+	std::string trace_path;
+	if (trace_to)
+	{
+		trace_path = trace_to;
+		std::size_t colon = trace_path.rfind(':');
+		std::uint32_t every = 1;
+		if (colon != std::string::npos)
+		{
+			every = std::uint32_t(std::strtoul(trace_path.c_str() + colon + 1, nullptr, 10));
+			trace_path.resize(colon);
+		}
+		dsa::trace_enable(every);
+	}
+#endif
+
+	std::printf("listening on %s\n", path);
+	std::fflush(stdout);
+	srv.run();
+	exporter.reset();
+#if defined(DSA_TRACE)
+	if (trace_to)
+	{
+		dsa::trace_disable();
+		std::printf("%ld trace events to %s\n", dsa::trace_dump(trace_path.c_str()), trace_path.c_str());
+	}
+#endif
+
+	close(efd);
+	close(lfd);
+	unlink(path);
+	return 0;
+}
@@ -0,0 +1,75 @@
+#ifndef LIST_STATS_H
+#define LIST_STATS_H
+#include<stdio.h>
+#include<limits.h>
+//Running summary of a list's contents, a member of the list's own struct
+//(struct SLL, DLL, CSLL, CDLL, Stack, Queue) beside its node pointers, so
+//each list carries its own. Every insert and delete updates it, and
+//length, sum, min, max and a checksum are read in O(1) instead of by a
+//traversal.
+//The checksum adds a mixed copy of every item, so it does not depend on
+//order: sort and reverse leave the whole summary unchanged.
+//Deleting the current min or max only marks the extremes stale; the
+//program rescans once, on the next read that needs them:
+//    if(s->extremes_stale){
+//        stats_rescan_begin(s);
+//        for(each node) stats_rescan(s,node->info);
+//    }
+struct ListStats{
+    int length;
+    long long sum;
+    int min,max;
+    int extremes_stale;
+    unsigned long long checksum;
+};
+static unsigned long long stats_mix(int item){
+    unsigned long long x=(unsigned long long)(unsigned int)item+0x9e3779b97f4a7c15ULL;
+    x=(x^(x>>30))*0xbf58476d1ce4e5b9ULL;
+    x=(x^(x>>27))*0x94d049bb133111ebULL;
+    return x^(x>>31);
+}
+static void stats_reset(struct ListStats* s){
+    s->length=0;
+    s->sum=0;
+    s->min=INT_MAX;
+    s->max=INT_MIN;
+    s->extremes_stale=0;
+    s->checksum=0;
+}
+static void stats_add(struct ListStats* s,int item){
+    s->length++;
+    s->sum+=item;
+    s->checksum+=stats_mix(item);
+    if(item<s->min)
+        s->min=item;
+    if(item>s->max)
+        s->max=item;
+}
+static void stats_remove(struct ListStats* s,int item){
+    s->length--;
+    s->sum-=item;
+    s->checksum-=stats_mix(item);
+    if(s->length==0)
+        stats_reset(s);
+    else if(item==s->min || item==s->max)
+        s->extremes_stale=1;
+}
+static void stats_rescan_begin(struct ListStats* s){
+    s->min=INT_MAX;
+    s->max=INT_MIN;
+    s->extremes_stale=0;
+}
+static void stats_rescan(struct ListStats* s,int item){
+    if(item<s->min)
+        s->min=item;
+    if(item>s->max)
+        s->max=item;
+}
+static void stats_print(const struct ListStats* s){
+    if(s->length==0)
+        printf("\nlength=0\n");
+    else
+        printf("\nlength=%d sum=%lld min=%d max=%d checksum=%016llx\n",
+            s->length,s->sum,s->min,s->max,s->checksum);
+}
+#endif
@@ -0,0 +1,248 @@
+// Timeline tracing of list operations, dumped as Chrome trace-event JSON
+// (open in ui.perfetto.dev or chrome://tracing).
+//
+//   #define DSA_TRACE              // before the first dsa include: instruments
+//   #include "list_engine.hpp"     // the engine ops, sort and pool refills
+//
+//   dsa::trace_enable(100);        // keep one top-level op in 100
+//   ...
+//   dsa::trace_disable();
+//   dsa::trace_dump("lists.json");
+//
+//   void rebalance() { DSA_TRACE_SCOPE("rebalance", "app"); ... }   // own phases
+//
+// Every thread writes complete ("X") events into its own ring of the last
+// trace_ring_capacity events, so recording takes no lock and shares no
+// cache line. An event costs two timestamp reads (rdtsc on x86) and one
+// 40-byte store. Sampling is decided at top-level scopes: the nested
+// phases of a sampled op are all kept, those of a skipped op none.
+// Without DSA_TRACE the DSA_TRACE_SCOPE sites compile to nothing.
+//
+// Call trace_dump() with tracing disabled and the traced threads idle;
+// rings outlive their threads, so events of finished threads are kept.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dsa {
+
+constexpr std::size_t trace_ring_capacity = std::size_t(1) << 16;
+
+namespace trace_detail {
+
+inline std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+struct event
+{
+	const char * name;
+	const char * cat;
+	std::uint64_t start;
+	std::uint64_t end;
+	std::int64_t arg;
+};
+
+struct ring
+{
+	explicit ring(long t) : events(trace_ring_capacity), tid(t) {}
+
+	std::vector<event> events;
+	std::atomic<std::uint64_t> head{0}; // events ever written
+	long tid;
+	unsigned depth = 0;                 // open scopes on this thread
+	bool sampled = false;               // current top-level op is kept
+	std::uint64_t tops = 0;             // top-level scopes seen
+};
+
+struct state
+{
+	std::atomic<bool> on{false};
+	std::atomic<std::uint32_t> every{1};
+	std::mutex mu; // guards rings and the time base
+	std::vector<std::unique_ptr<ring>> rings;
+	bool based = false;
+	std::uint64_t base_ticks = 0;
+	std::chrono::steady_clock::time_point base_time;
+};
+
+inline state & global()
+{
+	static state s;
+	return s;
+}
+
+inline long thread_id()
+{
+#if defined(__linux__)
+	return long(syscall(SYS_gettid));
+#else
+	static std::atomic<long> next{1};
+	return next.fetch_add(1);
+#endif
+}
+
+inline ring & local()
+{
+	thread_local ring * r = nullptr;
+	if (r == nullptr)
+	{
+		state & s = global();
+		auto owned = std::make_unique<ring>(thread_id());
+		r = owned.get();
+		std::lock_guard<std::mutex> lk(s.mu);
+		s.rings.push_back(std::move(owned));
+	}
+	return *r;
+}
+
+} // namespace trace_detail
+
+// Starts recording, keeping one top-level scope in `sample_every`.
+inline void trace_enable(std::uint32_t sample_every = 1)
+{
+	trace_detail::state & s = trace_detail::global();
+	{
+		std::lock_guard<std::mutex> lk(s.mu);
+		if (!s.based)
+		{
+			s.base_ticks = trace_detail::ticks();
+			s.base_time = std::chrono::steady_clock::now();
+			s.based = true;
+		}
+	}
+	s.every.store(sample_every ? sample_every : 1, std::memory_order_relaxed);
+	s.on.store(true, std::memory_order_release);
+}
+
+inline void trace_disable()
+{
+	trace_detail::global().on.store(false, std::memory_order_release);
+}
+
+// Records one event from construction to destruction.
+class trace_scope
+{
+public:
+	trace_scope(const char * name, const char * cat, std::int64_t arg = 0)
+	{
+		trace_detail::state & s = trace_detail::global();
+		if (!s.on.load(std::memory_order_relaxed))
+			return;
+		trace_detail::ring & r = trace_detail::local();
+		if (r.depth++ == 0)
+			r.sampled = r.tops++ % s.every.load(std::memory_order_relaxed) == 0;
+		ring_ = &r;
+		if (r.sampled)
+		{
+			name_ = name;
+			cat_ = cat;
+			arg_ = arg;
+			start_ = trace_detail::ticks();
+		}
+	}
+
+	~trace_scope()
+	{
+		if (ring_ == nullptr)
+			return;
+		if (ring_->sampled && name_ != nullptr)
+		{
+			std::uint64_t h = ring_->head.load(std::memory_order_relaxed);
+			ring_->events[h % trace_ring_capacity] = {name_, cat_, start_, trace_detail::ticks(), arg_};
+			ring_->head.store(h + 1, std::memory_order_release);
+		}
+		ring_->depth--;
+	}
+
+	trace_scope(const trace_scope &) = delete;
+	trace_scope & operator=(const trace_scope &) = delete;
+
+private:
+	trace_detail::ring * ring_ = nullptr;
+	const char * name_ = nullptr;
+	const char * cat_ = nullptr;
+	std::int64_t arg_ = 0;
+	std::uint64_t start_ = 0;
+};
+
+// Writes every ring as Chrome trace-event JSON. Returns events written,
+// or -1 if the file could not be written.
+inline long trace_dump(const char * path)
+{
+	trace_detail::state & s = trace_detail::global();
+	std::lock_guard<std::mutex> lk(s.mu);
+	std::FILE * f = std::fopen(path, "w");
+	if (f == nullptr)
+		return -1;
+	// Tick rate from the span since trace_enable; 1 tick = 1 ns off x86.
+	double ticks_per_us = 1000.0;
+	if (s.based)
+	{
+		double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s.base_time).count();
+		std::uint64_t dt = trace_detail::ticks() - s.base_ticks;
+		if (us > 0 && dt > 0)
+			ticks_per_us = double(dt) / us;
+	}
+#if defined(__linux__)
+	long pid = long(getpid());
+#else
+	long pid = 1;
+#endif
+	long written = 0;
+	std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+	const char * sep = "";
+	for (const auto & r : s.rings)
+	{
+		std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":\"list thread %ld\"}}",
+			sep, pid, r->tid, r->tid);
+		sep = ",\n";
+		std::uint64_t head = r->head.load(std::memory_order_acquire);
+		std::uint64_t first = head > trace_ring_capacity ? head - trace_ring_capacity : 0;
+		for (std::uint64_t i = first; i < head; i++)
+		{
+			const trace_detail::event & e = r->events[i % trace_ring_capacity];
+			double ts = double(std::int64_t(e.start - s.base_ticks)) / ticks_per_us;
+			double dur = double(e.end - e.start) / ticks_per_us;
+			std::fprintf(f, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%ld,\"args\":{\"arg\":%lld}}",
+				sep, e.name, e.cat, ts, dur, pid, r->tid, static_cast<long long>(e.arg));
+			written++;
+		}
+	}
+	std::fputs("\n]}\n", f);
+	if (std::fclose(f) != 0)
+		return -1;
+	return written;
+}
+
+} // namespace dsa
+
+#define DSA_TRACE_CAT2(a, b) a##b
+#define DSA_TRACE_CAT(a, b) DSA_TRACE_CAT2(a, b)
+// DSA_TRACE_SCOPE_ARG also records an integer shown as the event's args.arg.
+#if defined(DSA_TRACE)
+#define DSA_TRACE_SCOPE(name, cat) ::dsa::trace_scope DSA_TRACE_CAT(dsa_trace_, __LINE__)(name, cat)
+#define DSA_TRACE_SCOPE_ARG(name, cat, arg) ::dsa::trace_scope DSA_TRACE_CAT(dsa_trace_, __LINE__)(name, cat, arg)
+#else
+#define DSA_TRACE_SCOPE(name, cat) ((void)0)
+#define DSA_TRACE_SCOPE_ARG(name, cat, arg) ((void)0)
+#endif
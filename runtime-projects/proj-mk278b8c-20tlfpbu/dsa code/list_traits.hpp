@@ -0,0 +1,97 @@
+// Shape adapters for the C++ list engine.
+// Any node struct in this folder (info/data payload, link/next successor)
+// can be walked through next_of()/value_of() without copying it.
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace dsa {
+
+// Node layouts matching the C programs (menu_linked.c, menu_DLL.c, ...).
+template <class T>
+struct sll_node
+{
+	T info;
+	sll_node * link;
+};
+
+template <class T>
+struct dll_node
+{
+	T info;
+	dll_node * prev;
+	dll_node * next;
+};
+
+template <class N, class = void>
+struct has_link : std::false_type {};
+template <class N>
+struct has_link<N, std::void_t<decltype(std::declval<N &>().link)>> : std::true_type {};
+
+template <class N, class = void>
+struct has_info : std::false_type {};
+template <class N>
+struct has_info<N, std::void_t<decltype(std::declval<N &>().info)>> : std::true_type {};
+
+template <class N, class = void>
+struct has_prev : std::false_type {};
+template <class N>
+struct has_prev<N, std::void_t<decltype(std::declval<N &>().prev)>> : std::true_type {};
+
+// Successor slot: `link` for SLL/CSLL/stack/queue, `next` for DLL/CDLL.
+template <class N>
+inline decltype(auto) next_of(N * n)
+{
+	if constexpr (has_link<N>::value)
+		return (n->link);
+	else
+		return (n->next);
+}
+
+// Payload slot: `info` everywhere except linked_insert.c which uses `data`.
+template <class N>
+inline decltype(auto) value_of(N * n)
+{
+	if constexpr (has_info<N>::value)
+		return (n->info);
+	else
+		return (n->data);
+}
+
+template <class N>
+using value_type_of = std::remove_reference_t<decltype(value_of(std::declval<N *>()))>;
+
+// Result of engine ops that can fail. Mirrors the OVERFLOW/UNDERFLOW
+// messages the C programs print, without the printf.
+enum class list_status { ok, overflow, underflow, not_found };
+
+// Walk shape of a chain: NULL-terminated or circular back to start.
+enum class walk { linear, circular };
+
+// Calls f(node) for each node in order; stops early when f returns false.
+template <walk W, class N, class F>
+inline void walk_nodes(N * start, F && f)
+{
+	if (start == nullptr)
+		return;
+	if constexpr (W == walk::linear)
+	{
+		for (N * ptr = start; ptr != nullptr; ptr = next_of(ptr))
+			if (!f(ptr))
+				return;
+	}
+	else
+	{
+		N * ptr = start;
+		do
+		{
+			N * nxt = next_of(ptr);
+			if (!f(ptr))
+				return;
+			ptr = nxt;
+		} while (ptr != start);
+	}
+}
+
+} // namespace dsa
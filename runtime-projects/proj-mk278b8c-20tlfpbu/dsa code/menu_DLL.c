@@ -1,24 +1,49 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"retire.h"
+#include"list_stats.h"
+#include"display.h"
+#include"list_probes.h"
 struct Node{
     int info;
     struct Node* prev;
     struct Node* next;
 };
-struct Node* foreward_traversal(struct Node* start){
-    struct Node* ptr=start;
-    if(start=NULL){
+//A DLL is its start pointer plus the running stats of its items.
+struct DLL{
+    struct Node* start;
+    struct ListStats stats;
+};
+//Full dump, for the Foreward_Traversal entry.
+void foreward_traversal(struct DLL* list){
+    struct Node* start=list->start,*ptr=start;
+    if(start==NULL){
         printf("list is empty");
     }
     else{
         printf("list is:");
         while(ptr!=NULL){
-            printf("%d\t",ptr->info);
+            out_int(ptr->info);
             ptr=ptr->next;
         }
+        out_dump_end();
+    }
+}
+//First and last K items, length and checksum; shown after each op.
+void display(struct DLL* list){
+    struct Node* start=list->start,*ptr;
+    struct Window w;
+    if(start==NULL){
+        printf("list is empty");
+        return;
     }
+    printf("list is:");
+    window_begin(&w);
+    for(ptr=start;ptr!=NULL;ptr=ptr->next)
+        window_item(&w,ptr->info);
+    window_end(&w,&list->stats);
 }
-struct Node* create_dll(struct Node* start){
+void create_dll(struct DLL* list){
     struct Node* new;
     int item;
     new=(struct Node*)malloc(sizeof(struct Node));
@@ -31,15 +56,16 @@ struct Node* create_dll(struct Node* start){
         new->info=item;
         new->prev=NULL;
         new->next=NULL;
-        if(start==NULL){
-            start=new;
+        if(list->start==NULL){
+            list->start=new;
+            stats_add(&list->stats,item);
         }
     }
-    return start;
 }
-struct Node* insert_beg(struct Node* start){
-    struct Node* new;
-    int item;
+void insert_beg(struct DLL* list){
+    struct Node* new,*start=list->start;
+    int item=0;
+    LIST_PROBE3(insert_beg_entry,&list->stats,list->stats.length,0);
 
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
@@ -49,6 +75,7 @@ struct Node* insert_beg(struct Node* start){
         printf("enter item to be inserted:");
         scanf("%d",&item);
         new->info=item;
+        stats_add(&list->stats,item);
         new->next=NULL;
         new->prev=NULL;
         if(start==NULL){
@@ -60,11 +87,13 @@ struct Node* insert_beg(struct Node* start){
             start=new;
         }
     }
-    return start;
+    list->start=start;
+    LIST_PROBE3(insert_beg_return,&list->stats,list->stats.length,item);
 }
-struct Node* insert_end(struct Node* start){
-    struct Node* new,*prev,* ptr=start;
-    int item,i=1;
+void insert_end(struct DLL* list){
+    struct Node* new,*start=list->start,* ptr=start;
+    int item=0,i=1;
+    LIST_PROBE3(insert_end_entry,&list->stats,list->stats.length,0);
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
         printf("OVERFLOW");
@@ -73,6 +102,7 @@ struct Node* insert_end(struct Node* start){
         printf("enter item to be insert:");
         scanf("%d",&item);
         new->info=item;
+        stats_add(&list->stats,item);
         new->prev=NULL;
         new->next=NULL;
         if(start==NULL){
@@ -86,12 +116,14 @@ struct Node* insert_end(struct Node* start){
             }
             ptr->next=new;
             new->prev=ptr;
+            LIST_PROBE_WALK(&list->stats,i-1,LIST_WALK_INSERT_END);
         }
     }
-    return start;
+    list->start=start;
+    LIST_PROBE3(insert_end_return,&list->stats,list->stats.length,item);
 }
-struct Node* insert_LOC(struct Node* start){
-    struct Node* new,*ptr,*ptr1;
+void insert_LOC(struct DLL* list){
+    struct Node* new,*start=list->start,*ptr,*ptr1;
     int item,loc,i=1;
     new=(struct Node*)malloc(sizeof(struct Node));
     if(new==NULL){
@@ -105,6 +137,7 @@ struct Node* insert_LOC(struct Node* start){
         new->prev=NULL;
         if(start==NULL){
             start=new;
+            stats_add(&list->stats,item);
         }
         else{
             ptr1=start;
@@ -117,11 +150,13 @@ struct Node* insert_LOC(struct Node* start){
                 printf("location not found");
             }
             else if(ptr1==start){
+                stats_add(&list->stats,item);
                 new->next=start;
                 start->prev=new;
                 start=new;
             }
             else{
+              stats_add(&list->stats,item);
               ptr->next=new;
               new->prev=ptr;
               new->next=ptr1;
@@ -129,24 +164,32 @@ struct Node* insert_LOC(struct Node* start){
             }
         }
     }
-    return start; 
+    list->start=start;
 }
-struct Node* delete_beg(struct Node* start){
-    struct Node* ptr;
+void delete_beg(struct DLL* list){
+    struct Node* start=list->start,*ptr;
+    int item=0;
+    LIST_PROBE3(delete_beg_entry,&list->stats,list->stats.length,0);
     if(start==NULL){
         printf("UNDERFLOW");
     }
     else{
         ptr=start;
-        printf("Deleted item is %d",ptr->info);
+        item=ptr->info;
+        printf("Deleted item is %d",item);
+        stats_remove(&list->stats,item);
         start=start->next;
-        start->prev=NULL;
-        free(ptr);
+        if(start!=NULL)
+            start->prev=NULL;
+        retire(ptr);
     }
-    return start;
+    list->start=start;
+    LIST_PROBE3(delete_beg_return,&list->stats,list->stats.length,item);
 }
-struct Node* delete_end(struct Node* start){
-    struct Node* ptr,*prev;
+void delete_end(struct DLL* list){
+    struct Node* start=list->start,*ptr,*prev;
+    int item=0;
+    LIST_PROBE3(delete_end_entry,&list->stats,list->stats.length,0);
     if(start==NULL){
         printf("UNDERFLOW");
     }
@@ -156,51 +199,76 @@ struct Node* delete_end(struct Node* start){
             prev=ptr;
             ptr=ptr->next;
         }
-        printf("deleted item is %d",ptr->info);
-        prev->next=NULL;
-        free(ptr);
+        LIST_PROBE_WALK(&list->stats,list->stats.length-1,LIST_WALK_DELETE_END);
+        item=ptr->info;
+        printf("deleted item is %d",item);
+        stats_remove(&list->stats,item);
+        if(ptr==start)
+            start=NULL; //it was the only node
+        else
+            prev->next=NULL;
+        retire(ptr);
     }
-    return start;
+    list->start=start;
+    LIST_PROBE3(delete_end_return,&list->stats,list->stats.length,item);
+}
+//O(1) unless a delete took the min or max; then one rescan.
+void show_stats(struct DLL* list){
+    struct Node* ptr;
+    if(list->stats.extremes_stale){
+        stats_rescan_begin(&list->stats);
+        for(ptr=list->start;ptr!=NULL;ptr=ptr->next)
+            stats_rescan(&list->stats,ptr->info);
+    }
+    stats_print(&list->stats);
 }
 int main(){
-    struct Node* start=NULL;
-    int option,item;
-    start=create_dll(start);
+    struct DLL list;
+    int option;
+    list.start=NULL;
+    stats_reset(&list.stats);
+    window_init();
+    create_dll(&list);
     do{
-        printf("\nMENU:\n1->Foreward_Traversal\n2->Insert_Beg\n3->Insert_End\n4->Insert_LOC\n5->Delete_Beg\n6->Delete_End\n7->Exit\n");
+        retire_flush();
+        out_sync();
+        printf("\nMENU:\n1->Foreward_Traversal\n2->Insert_Beg\n3->Insert_End\n4->Insert_LOC\n5->Delete_Beg\n6->Delete_End\n7->Stats\n8->Exit\n");
         printf("Enter your option:");
         scanf("%d",&option);
         switch(option){
             case 1:
-                start=foreward_traversal(start);
+                foreward_traversal(&list);
                 break;
             case 2:
-                start=insert_beg(start);
-                foreward_traversal(start);
+                insert_beg(&list);
+                display(&list);
 
                 break;
             case 3:
-                start=insert_end(start);
-                foreward_traversal(start);
+                insert_end(&list);
+                display(&list);
                 break;
             case 4:
-                start=insert_LOC(start);
-                foreward_traversal(start);
+                insert_LOC(&list);
+                display(&list);
                 break;
             case 5:
-                start=delete_beg(start);
-                foreward_traversal(start);
+                delete_beg(&list);
+                display(&list);
                 break;
             case 6:
-                start=delete_end(start);
-                foreward_traversal(start);
+                delete_end(&list);
+                display(&list);
                 break;
             case 7:
+                show_stats(&list);
+                break;
+            case 8:
                 printf("Exiting...");
                 break;
             default:
                 printf("Invalid option");
                 break;
         }
-    }while(option!=7);
+    }while(option!=8);
 }
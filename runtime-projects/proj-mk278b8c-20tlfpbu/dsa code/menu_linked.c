@@ -1,12 +1,22 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"retire.h"
+#include"list_stats.h"
+#include"display.h"
+#include"list_probes.h"
 //ADT for SLL.Self-Referential Structure.
 struct node
 {
 	int info;
 	struct node * link;
 };
-struct node * create_sll(struct node * start)
+//An SLL is its start pointer plus the running stats of its items.
+struct SLL
+{
+	struct node * start;
+	struct ListStats stats;
+};
+void create_sll(struct SLL * list)
 {
 	struct node * new;
 	int item;
@@ -19,25 +29,41 @@ struct node * create_sll(struct node * start)
 		scanf("%d",&item);
 		new->info=item;
 		new->link=NULL;
-		if(start==NULL)
-			start = new;
+		if(list->start==NULL)
+		{
+			list->start = new;
+			stats_add(&list->stats,item);
+		}
 	}
-	return start;
 }
-void traversal(struct node *start)
+//Full dump, for the Traversal entry.
+void traversal(struct SLL * list)
 {
-	struct node * ptr = start;
+	struct node * ptr = list->start;
 	printf("\nContent of the SLL:\n");
 	while(ptr!=NULL)
 	{
-		printf("%d\t",ptr->info);
+		out_int(ptr->info);
 		ptr=ptr->link;
 	}
+	out_dump_end();
 }
-struct node * insert_beg(struct node * start)
+//First and last K items, length and checksum; shown after each op.
+void display(struct SLL * list)
 {
-	struct node * new;
-	int item;
+	struct node * ptr;
+	struct Window w;
+	printf("\nContent of the SLL:\n");
+	window_begin(&w);
+	for(ptr=list->start;ptr!=NULL;ptr=ptr->link)
+		window_item(&w,ptr->info);
+	window_end(&w,&list->stats);
+}
+void insert_beg(struct SLL * list)
+{
+	struct node * new, *start = list->start;
+	int item=0;
+	LIST_PROBE3(insert_beg_entry,&list->stats,list->stats.length,0);
 	new=(struct node *)malloc(sizeof(struct node));
 	if(new==NULL)
 		printf("\nOVERFLOW\n");
@@ -47,6 +73,7 @@ struct node * insert_beg(struct node * start)
 		scanf("%d",&item);
 		new->info=item;
 		new->link=NULL;
+		stats_add(&list->stats,item);
 		if(start==NULL)
 			start = new;
 		else
@@ -55,12 +82,14 @@ struct node * insert_beg(struct node * start)
 			start=new;
 		}
 	}
-	return start;
+	list->start=start;
+	LIST_PROBE3(insert_beg_return,&list->stats,list->stats.length,item);
 }
-struct node * insert_end(struct node * start)
+void insert_end(struct SLL * list)
 {
-	struct node * new, *ptr = start;
-	int item;
+	struct node * new, *start = list->start, *ptr = start;
+	int item=0;
+	LIST_PROBE3(insert_end_entry,&list->stats,list->stats.length,0);
 	new=(struct node *)malloc(sizeof(struct node));
 	if(new==NULL)
 		printf("\nOVERFLOW\n");
@@ -70,6 +99,7 @@ struct node * insert_end(struct node * start)
 		scanf("%d",&item);
 		new->info=item;
 		new->link=NULL;
+		stats_add(&list->stats,item);
 		if(start==NULL)
 			start = new;
 		else
@@ -77,26 +107,35 @@ struct node * insert_end(struct node * start)
 			while(ptr->link!=NULL)
 				ptr=ptr->link;
 			ptr->link=new;
+			LIST_PROBE_WALK(&list->stats,list->stats.length-2,LIST_WALK_INSERT_END); //length already counts new
 		}
 	}
-	return start;
+	list->start=start;
+	LIST_PROBE3(insert_end_return,&list->stats,list->stats.length,item);
 }
-struct node * delete_beg(struct node * start)
+void delete_beg(struct SLL * list)
 {
-	struct node *ptr=start;
+	struct node *start=list->start,*ptr=start;
+	int item=0;
+	LIST_PROBE3(delete_beg_entry,&list->stats,list->stats.length,0);
 	if(start==NULL)
 		printf("\nUNDERFLOW\n");
 	else
 	{
-		printf("\nItem Deleted=%d\n",ptr->info);
+		item=ptr->info;
+		printf("\nItem Deleted=%d\n",item);
+		stats_remove(&list->stats,item);
 		start=ptr->link;
-		free(ptr);
+		retire(ptr);
 	}
-	return start;
+	list->start=start;
+	LIST_PROBE3(delete_beg_return,&list->stats,list->stats.length,item);
 }
-struct node * delete_end(struct node * start)
+void delete_end(struct SLL * list)
 {
-	struct node *ptr=start,*prev=start;
+	struct node *start=list->start,*ptr=start,*prev=start;
+	int item=0;
+	LIST_PROBE3(delete_end_entry,&list->stats,list->stats.length,0);
 	if(start==NULL)
 		printf("\nUNDERFLOW\n");
 	else
@@ -106,26 +145,36 @@ struct node * delete_end(struct node * start)
 			prev=ptr;
 			ptr=ptr->link;
 		}
-		printf("\nItem Deleted=%d\n",ptr->info);
-		prev->link=NULL;
-		free(ptr);
+		LIST_PROBE_WALK(&list->stats,list->stats.length-1,LIST_WALK_DELETE_END);
+		item=ptr->info;
+		printf("\nItem Deleted=%d\n",item);
+		stats_remove(&list->stats,item);
+		if(ptr==start)
+			start=NULL; //it was the only node
+		else
+			prev->link=NULL;
+		retire(ptr);
 	}
-	return start;
+	list->start=start;
+	LIST_PROBE3(delete_end_return,&list->stats,list->stats.length,item);
 }
-void searching_sll(struct node * start, int item)
+void searching_sll(struct SLL * list, int item)
 {
-	struct node * ptr = start;
+	struct node * ptr = list->start;
 	int loc=1;
+	LIST_PROBE3(search_entry,&list->stats,list->stats.length,item);
 	while(ptr!=NULL && ptr->info!=item)
 		{ ptr=ptr->link;loc++;}
+	LIST_PROBE_WALK(&list->stats,loc-1,LIST_WALK_SEARCH);
 	if(ptr==NULL)
 		printf("\nUnsuccsful Search.\n");
 	else
 		printf("\n%d found at %d Node.\n",item,loc);
+	LIST_PROBE3(search_return,&list->stats,list->stats.length,ptr!=NULL?loc:0);
 }
-void sorting_sll(struct node * start)
+void sorting_sll(struct SLL * list)
 {
-	struct node * ptr1=start,*ptr2;
+	struct node * ptr1=list->start,*ptr2;
 	int temp;
 	while(ptr1->link!=NULL)
 	{
@@ -143,9 +192,9 @@ void sorting_sll(struct node * start)
 		ptr1=ptr1->link;
 	}
 }
-struct node * reversal(struct node * start)
+void reversal(struct SLL * list)
 {
-	struct node *ptr=start,*prev=NULL,*temp;
+	struct node *ptr=list->start,*prev=NULL,*temp;
 	while(ptr!=NULL)
 	{
 		temp=ptr->link;
@@ -153,45 +202,62 @@ struct node * reversal(struct node * start)
 		prev=ptr;
 		ptr=temp;
 	}
-	start=prev;
-	return start;
+	list->start=prev;
+}
+//O(1) unless a delete took the min or max; then one rescan.
+void show_stats(struct SLL * list)
+{
+	struct node * ptr;
+	if(list->stats.extremes_stale)
+	{
+		stats_rescan_begin(&list->stats);
+		for(ptr=list->start;ptr!=NULL;ptr=ptr->link)
+			stats_rescan(&list->stats,ptr->info);
+	}
+	stats_print(&list->stats);
 }
 int main()
 {
-	struct node * start = NULL;
+	struct SLL list;
 	int option, item;
-	start=create_sll(start);
+	list.start = NULL;
+	stats_reset(&list.stats);
+	window_init();
+	create_sll(&list);
 	do
 	{
+	retire_flush();
+	out_sync();
 	printf("\nMENU:\n1.Traversal.\n2.Insert_Beg\n3.Insert_End\n");
 	printf("4.Delete_Beg\n5.Delete_End.\n");
-	printf("6.Searching_Sll\n7.Sorting_Sll\n8.Reverse.\n9.Exit.\n");
+	printf("6.Searching_Sll\n7.Sorting_Sll\n8.Reverse.\n9.Stats.\n10.Exit.\n");
 	printf("\nEnter Your Choice:\n");
 	scanf("%d",&option);
 	switch(option)
 	{
-		case 1:traversal(start);break;
-		case 2:start=insert_beg(start);traversal(start);break;
-		case 3:start=insert_end(start);traversal(start);break;
-		case 4:start=delete_beg(start);traversal(start);break;
-		case 5:start=delete_end(start);traversal(start);break;
+		case 1:traversal(&list);break;
+		case 2:insert_beg(&list);display(&list);break;
+		case 3:insert_end(&list);display(&list);break;
+		case 4:delete_beg(&list);display(&list);break;
+		case 5:delete_end(&list);display(&list);break;
 		case 6: printf("\nEnter item to be searched:\n");
 				scanf("%d",&item);
-				searching_sll(start,item);
+				searching_sll(&list,item);
 				break;
 		case 7: printf("\nBefore Sorting:\n");
-				traversal(start);
-				sorting_sll(start);
+				display(&list);
+				sorting_sll(&list);
 				printf("\nAfter Sorting:\n");
-				traversal(start);break;
+				display(&list);break;
 		case 8: printf("\nBefore Reversal:\n");
-				traversal(start);
-				start=reversal(start);
+				display(&list);
+				reversal(&list);
 				printf("\nAfter Reversal:\n");
-				traversal(start);break;
-		case 9: exit(0);
+				display(&list);break;
+		case 9: show_stats(&list);break;
+		case 10: exit(0);
 	}
-	}while(option<10);
+	}while(option<11);
 	return 0;
 }
 
@@ -0,0 +1,425 @@
+// Fixed-size node pool as a std::pmr::memory_resource, for the engine
+// lists' insert_beg/push/enqueue paths.
+//
+// Nodes are carved from 64 KiB chunks aligned to their size, so the chunk
+// of a node is found by masking its address. Every chunk counts its live
+// nodes. Once more than `high_empty` chunks are completely free, the pool
+// madvises the pages of the surplus back to the kernel until only
+// `low_empty` are left (hysteresis). The chunks stay mapped: reusing one
+// only faults fresh zero pages back in. RSS therefore follows live data
+// instead of the peak.
+//
+// A pool is single-threaded, like the lists it serves. pressure_watcher
+// (Linux PSI) may request a full trim from its own thread; the owner
+// performs it on its next allocate/deallocate.
+//
+// USDT probes (list_probes.h): pool_refill(pool, chunks, live nodes) when
+// the current chunk runs out, pool_trim(pool, chunks) before a trim.
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include "list_probes.h"
+#include "list_trace.hpp"
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace dsa {
+
+struct pool_trim_policy
+{
+	std::size_t high_empty = 8; // trim once more than this many chunks are empty...
+	std::size_t low_empty = 2;  // ...down to this many
+	bool lazy_free = false;     // MADV_FREE (reclaimed under pressure) instead of MADV_DONTNEED
+};
+
+struct pool_stats
+{
+	std::size_t chunks = 0;        // chunks mapped
+	std::size_t empty_chunks = 0;  // fully free and still resident
+	std::size_t trimmed_chunks = 0;// fully free and given back to the kernel
+	std::size_t live_nodes = 0;
+	std::size_t trims = 0;         // trim passes run
+	std::size_t refills = 0;       // chunks mapped on demand
+	std::size_t oversize = 0;      // requests sent upstream
+};
+
+class node_pool : public std::pmr::memory_resource
+{
+public:
+	static constexpr std::size_t chunk_size = std::size_t(64) * 1024;
+
+	node_pool(std::size_t node_size, std::size_t node_align = alignof(std::max_align_t),
+		pool_trim_policy policy = pool_trim_policy(),
+		std::pmr::memory_resource * upstream = std::pmr::new_delete_resource())
+		: policy_(policy), upstream_(upstream)
+	{
+		align_ = node_align < alignof(void *) ? alignof(void *) : node_align;
+		block_ = round_up(node_size < sizeof(void *) ? sizeof(void *) : node_size, align_);
+		first_ = round_up(sizeof(chunk), align_);
+		// A node that does not fit a chunk beside the header (or an
+		// alignment past the chunk size) leaves nothing to carve: every
+		// request then goes upstream.
+		per_chunk_ = first_ < chunk_size ? (chunk_size - first_) / block_ : 0;
+	}
+
+	~node_pool() override
+	{
+		for (chunk * list : {partial_, full_, empty_, trimmed_})
+			while (list)
+			{
+				chunk * c = list;
+				list = c->next;
+				unmap(c);
+			}
+	}
+
+	node_pool(const node_pool &) = delete;
+	node_pool & operator=(const node_pool &) = delete;
+
+	std::size_t node_size() const { return block_; }
+	std::size_t node_align() const { return align_; }
+	const pool_stats & stats() const { return stats_; }
+	const pool_trim_policy & policy() const { return policy_; }
+	void set_policy(pool_trim_policy p) { policy_ = p; }
+
+	// Bytes of node memory that may be resident (everything but trimmed chunks).
+	std::size_t resident_bytes() const { return (stats_.chunks - stats_.trimmed_chunks) * chunk_size; }
+
+	// Gives back every empty chunk beyond `keep`.
+	void trim(std::size_t keep)
+	{
+		trim_requested_.store(false, std::memory_order_relaxed);
+		if (stats_.empty_chunks <= keep)
+			return;
+		DSA_TRACE_SCOPE_ARG("pool.trim", "pool", std::int64_t(stats_.empty_chunks - keep));
+		LIST_PROBE2(pool_trim, this, stats_.empty_chunks - keep);
+		stats_.trims++;
+		while (stats_.empty_chunks > keep)
+		{
+			chunk * c = empty_;
+			move(c, empty_, trimmed_);
+			stats_.empty_chunks--;
+			stats_.trimmed_chunks++;
+			advise_free(c);
+		}
+	}
+
+	// Safe from any thread: asks the owner to trim everything on its next op.
+	void request_trim() { trim_requested_.store(true, std::memory_order_relaxed); }
+
+	// Takes over every chunk of `other`, live nodes included, so nodes
+	// allocated from other are now deallocated through this pool. Lets
+	// threads fill private pools and hand the result to one owner. Costs
+	// one hop per chunk of other, none per node. Both pools must carve the
+	// same block size and alignment and share an upstream (oversize nodes
+	// of other are freed through it); returns false (and moves nothing)
+	// otherwise.
+	bool adopt(node_pool & other)
+	{
+		if (&other == this || other.block_ != block_ || other.align_ != align_ ||
+			!upstream_->is_equal(*other.upstream_))
+			return false;
+		splice(other.partial_, partial_);
+		splice(other.full_, full_);
+		splice(other.empty_, empty_);
+		splice(other.trimmed_, trimmed_);
+		stats_.chunks += other.stats_.chunks;
+		stats_.empty_chunks += other.stats_.empty_chunks;
+		stats_.trimmed_chunks += other.stats_.trimmed_chunks;
+		stats_.live_nodes += other.stats_.live_nodes;
+		stats_.trims += other.stats_.trims;
+		stats_.refills += other.stats_.refills;
+		stats_.oversize += other.stats_.oversize;
+		other.stats_ = pool_stats();
+		return true;
+	}
+
+protected:
+	void * do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		if (!pooled(bytes, align))
+		{
+			stats_.oversize++;
+			return upstream_->allocate(bytes, align);
+		}
+		if (trim_requested_.load(std::memory_order_relaxed))
+			trim(0);
+		chunk * c = partial_;
+		if (c == nullptr)
+			c = refill();
+		void * p;
+		if (c->free)
+		{
+			p = c->free;
+			c->free = *static_cast<void **>(p);
+		}
+		else
+		{
+			p = reinterpret_cast<char *>(c) + first_ + std::size_t(c->bump) * block_;
+			c->bump++;
+		}
+		c->live++;
+		stats_.live_nodes++;
+		if (c->live == per_chunk_)
+			move(c, partial_, full_);
+		return p;
+	}
+
+	void do_deallocate(void * p, std::size_t bytes, std::size_t align) override
+	{
+		if (!pooled(bytes, align))
+		{
+			upstream_->deallocate(p, bytes, align);
+			return;
+		}
+		chunk * c = reinterpret_cast<chunk *>(reinterpret_cast<std::uintptr_t>(p) & ~(std::uintptr_t(chunk_size) - 1));
+		*static_cast<void **>(p) = c->free;
+		c->free = p;
+		if (c->live == per_chunk_)
+			move(c, full_, partial_);
+		c->live--;
+		stats_.live_nodes--;
+		if (c->live == 0)
+		{
+			move(c, partial_, empty_);
+			stats_.empty_chunks++;
+			if (stats_.empty_chunks > policy_.high_empty)
+				trim(policy_.low_empty);
+		}
+		if (trim_requested_.load(std::memory_order_relaxed))
+			trim(0);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+
+private:
+	struct chunk
+	{
+		chunk * prev;
+		chunk * next;
+		void * free;        // recycled nodes
+		std::uint32_t bump; // nodes carved so far
+		std::uint32_t live;
+	};
+
+	static std::size_t round_up(std::size_t v, std::size_t a) { return (v + a - 1) / a * a; }
+
+	bool pooled(std::size_t bytes, std::size_t align) const
+	{
+		return per_chunk_ != 0 && bytes <= block_ && align <= align_;
+	}
+
+	static void unlink(chunk * c, chunk *& list)
+	{
+		(c->prev ? c->prev->next : list) = c->next;
+		if (c->next)
+			c->next->prev = c->prev;
+	}
+
+	static void push(chunk * c, chunk *& list)
+	{
+		c->prev = nullptr;
+		c->next = list;
+		if (list)
+			list->prev = c;
+		list = c;
+	}
+
+	// Moves the whole of list `from` to the front of `to`.
+	static void splice(chunk *& from, chunk *& to)
+	{
+		if (from == nullptr)
+			return;
+		chunk * last = from;
+		while (last->next)
+			last = last->next;
+		last->next = to;
+		if (to)
+			to->prev = last;
+		to = from;
+		from = nullptr;
+	}
+
+	static void move(chunk * c, chunk *& from, chunk *& to)
+	{
+		unlink(c, from);
+		push(c, to);
+	}
+
+	chunk * refill()
+	{
+		DSA_TRACE_SCOPE("pool.refill", "pool");
+		chunk * c;
+		if (empty_)
+		{
+			c = empty_;
+			stats_.empty_chunks--;
+			move(c, empty_, partial_);
+		}
+		else if (trimmed_)
+		{
+			c = trimmed_;
+			stats_.trimmed_chunks--;
+			move(c, trimmed_, partial_);
+		}
+		else
+		{
+			c = static_cast<chunk *>(map());
+			stats_.chunks++;
+			stats_.refills++;
+			push(c, partial_);
+		}
+		LIST_PROBE3(pool_refill, this, stats_.chunks, stats_.live_nodes);
+		// Fresh or fully free: carve from the start again.
+		c->free = nullptr;
+		c->bump = 0;
+		c->live = 0;
+		return c;
+	}
+
+	// Releases a free chunk's node pages but keeps the header page.
+	void advise_free(chunk * c)
+	{
+#if defined(__linux__)
+		std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+		std::size_t keep = round_up(sizeof(chunk), page);
+		int advice = MADV_DONTNEED;
+#if defined(MADV_FREE)
+		if (policy_.lazy_free)
+			advice = MADV_FREE;
+#endif
+		if (keep < chunk_size)
+			madvise(reinterpret_cast<char *>(c) + keep, chunk_size - keep, advice);
+#else
+		(void)c;
+#endif
+	}
+
+	static void * map()
+	{
+#if defined(__linux__)
+		// Over-map by one chunk and trim so the chunk is size-aligned.
+		std::size_t len = 2 * chunk_size;
+		void * raw = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED)
+			throw std::bad_alloc();
+		std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw);
+		std::uintptr_t aligned = (base + chunk_size - 1) & ~(std::uintptr_t(chunk_size) - 1);
+		if (aligned > base)
+			munmap(raw, aligned - base);
+		if (aligned + chunk_size < base + len)
+			munmap(reinterpret_cast<void *>(aligned + chunk_size), base + len - aligned - chunk_size);
+		return reinterpret_cast<void *>(aligned);
+#else
+		void * p = std::aligned_alloc(chunk_size, chunk_size);
+		if (p == nullptr)
+			throw std::bad_alloc();
+		return p;
+#endif
+	}
+
+	static void unmap(chunk * c)
+	{
+#if defined(__linux__)
+		munmap(c, chunk_size);
+#else
+		std::free(c);
+#endif
+	}
+
+	pool_trim_policy policy_;
+	std::pmr::memory_resource * upstream_;
+	std::size_t block_, align_, first_, per_chunk_;
+	chunk * partial_ = nullptr; // some free nodes
+	chunk * full_ = nullptr;    // no free nodes
+	chunk * empty_ = nullptr;   // no live nodes, resident
+	chunk * trimmed_ = nullptr; // no live nodes, pages given back
+	pool_stats stats_;
+	std::atomic<bool> trim_requested_{false};
+};
+
+// Watches Linux PSI memory pressure (system-wide or a cgroup's
+// memory.pressure file) and asks a pool to trim when the kernel reports a
+// stall above the threshold. Does nothing where PSI is unavailable.
+class pressure_watcher
+{
+public:
+	// stall_us of memory stall within window_us triggers a trim request.
+	pressure_watcher(node_pool & pool, const char * path = "/proc/pressure/memory",
+		unsigned stall_us = 150000, unsigned window_us = 1000000)
+		: pool_(pool)
+	{
+#if defined(__linux__)
+		fd_ = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+		if (fd_ < 0)
+			return;
+		char trig[64];
+		int n = std::snprintf(trig, sizeof trig, "some %u %u", stall_us, window_us);
+		if (write(fd_, trig, std::size_t(n) + 1) < 0)
+		{
+			close(fd_);
+			fd_ = -1;
+			return;
+		}
+		thread_ = std::thread([this] { run(); });
+#else
+		(void)path;
+		(void)stall_us;
+		(void)window_us;
+#endif
+	}
+
+	~pressure_watcher()
+	{
+		stop_.store(true);
+		if (thread_.joinable())
+			thread_.join();
+#if defined(__linux__)
+		if (fd_ >= 0)
+			close(fd_);
+#endif
+	}
+
+	pressure_watcher(const pressure_watcher &) = delete;
+	pressure_watcher & operator=(const pressure_watcher &) = delete;
+
+	bool active() const { return thread_.joinable(); }
+	std::size_t events() const { return events_.load(std::memory_order_relaxed); }
+
+private:
+	void run()
+	{
+#if defined(__linux__)
+		pollfd pfd{fd_, POLLPRI, 0};
+		while (!stop_.load())
+		{
+			int r = poll(&pfd, 1, 200);
+			if (r < 0 || (pfd.revents & POLLERR))
+				return;
+			if (r > 0 && (pfd.revents & POLLPRI))
+			{
+				events_.fetch_add(1, std::memory_order_relaxed);
+				pool_.request_trim();
+			}
+		}
+#endif
+	}
+
+	node_pool & pool_;
+	int fd_ = -1;
+	std::thread thread_;
+	std::atomic<bool> stop_{false};
+	std::atomic<std::size_t> events_{0};
+};
+
+} // namespace dsa
@@ -0,0 +1,89 @@
+#ifndef RETIRE_H
+#define RETIRE_H
+#include<stdlib.h>
+#include"list_probes.h"
+//Deferred free for the delete paths (delete_beg, delete_end, pop, dequeue).
+//A dead node is pushed on a retire list, with its own first word reused as
+//the link, so the delete itself never enters the allocator. retire_flush()
+//frees the whole list in one batch at a quiescent point, such as the top
+//of a menu loop while waiting for input.
+//Build with -DRETIRE_THREAD -pthread to hand each batch to a background
+//thread instead, so the frees never run on the caller's thread.
+//Probes: retire_flush(count) per batch, and retire_contended(count) when
+//the handoff finds the worker holding the lock.
+static void* retired=NULL;
+static void* retired_tail=NULL;
+static int retired_count=0;
+static void retire(void* ptr){
+    *(void**)ptr=retired;
+    if(retired==NULL)
+        retired_tail=ptr;
+    retired=ptr;
+    retired_count++;
+}
+static void free_chain(void* ptr){
+    void* next;
+    while(ptr!=NULL){
+        next=*(void**)ptr;
+        free(ptr);
+        ptr=next;
+    }
+}
+#ifdef RETIRE_THREAD
+#include<pthread.h>
+static pthread_mutex_t retire_mutex=PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t retire_cond=PTHREAD_COND_INITIALIZER;
+static void* retire_batch=NULL;
+static int retire_started=0;
+static void* retire_worker(void* arg){
+    void* batch;
+    (void)arg;
+    for(;;){
+        pthread_mutex_lock(&retire_mutex);
+        while(retire_batch==NULL)
+            pthread_cond_wait(&retire_cond,&retire_mutex);
+        batch=retire_batch;
+        retire_batch=NULL;
+        pthread_mutex_unlock(&retire_mutex);
+        free_chain(batch);
+    }
+    return NULL;
+}
+static void retire_flush(){
+    pthread_t worker;
+    if(retired==NULL)
+        return;
+    LIST_PROBE1(retire_flush,retired_count);
+    if(!retire_started){
+        if(pthread_create(&worker,NULL,retire_worker,NULL)!=0){
+            free_chain(retired);
+            retired=retired_tail=NULL;
+            retired_count=0;
+            return;
+        }
+        pthread_detach(worker);
+        retire_started=1;
+    }
+    //O(1) handoff: the new batch is put in front of any batch the worker
+    //has not picked up yet.
+    if(pthread_mutex_trylock(&retire_mutex)!=0){
+        LIST_PROBE1(retire_contended,retired_count);
+        pthread_mutex_lock(&retire_mutex);
+    }
+    *(void**)retired_tail=retire_batch;
+    retire_batch=retired;
+    pthread_cond_signal(&retire_cond);
+    pthread_mutex_unlock(&retire_mutex);
+    retired=retired_tail=NULL;
+    retired_count=0;
+}
+#else
+static void retire_flush(){
+    if(retired!=NULL)
+        LIST_PROBE1(retire_flush,retired_count);
+    free_chain(retired);
+    retired=retired_tail=NULL;
+    retired_count=0;
+}
+#endif
+#endif
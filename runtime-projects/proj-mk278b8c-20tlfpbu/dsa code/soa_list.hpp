@@ -0,0 +1,260 @@
+// Unrolled list whose blocks store each record field as its own column.
+//
+//   dsa::soa_list<64, int, double, inline_string<24>> list;   // key first
+//   list.insert_end(7, 2.5, "seven");
+//   list.search(7);                                           // key column only
+//   list.for_each_match([](int k) { return k > 5; },
+//                       [](auto row) { use(row.template get<2>()); });
+//
+// A record of a struct Node from menu_DLL.c widened with payload fields
+// interleaves the hot key with cold data, so a search pulls every byte of
+// every record through the cache. Here the keys of a block are one dense
+// array: search, count_if and the predicate side of for_each_match read
+// only that array, and cold columns are touched only for matching rows.
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <tuple>
+#include <utility>
+#include "list_kernels.hpp"
+#include "list_traits.hpp"
+
+namespace dsa {
+
+template <std::size_t B, class Key, class... Cold>
+class soa_list
+{
+	static_assert(B >= 2, "blocks must hold at least two records");
+
+	struct block
+	{
+		block * prev;
+		block * next;
+		std::uint32_t begin; // live rows are [begin, begin + count)
+		std::uint32_t count;
+		Key keys[B];
+		std::tuple<std::array<Cold, B>...> cold;
+	};
+
+public:
+	using key_type = Key;
+	static constexpr std::size_t block_capacity = B;
+
+	// Lazy view of one row; get<0>() is the key, get<1..>() the cold fields.
+	// A const_row (from a const list) hands out const references.
+	template <class Block>
+	class basic_row
+	{
+	public:
+		template <std::size_t I>
+		decltype(auto) get() const
+		{
+			if constexpr (I == 0)
+				return (b_->keys[i_]);
+			else
+				return (std::get<I - 1>(b_->cold)[i_]);
+		}
+
+	private:
+		friend class soa_list;
+		basic_row(Block * b, std::uint32_t i) : b_(b), i_(i) {}
+		Block * b_;
+		std::uint32_t i_;
+	};
+	using row = basic_row<block>;
+	using const_row = basic_row<const block>;
+
+	explicit soa_list(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : mr_(mr) {}
+	~soa_list() { clear(); }
+	soa_list(const soa_list &) = delete;
+	soa_list & operator=(const soa_list &) = delete;
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+
+	list_status insert_beg(Key key, Cold... cold)
+	{
+		if (head_ == nullptr || head_->begin == 0)
+		{
+			block * b = make_block(B);
+			if (b == nullptr)
+				return list_status::overflow;
+			link_before(head_, b);
+		}
+		head_->count++;
+		put(head_, --head_->begin, std::move(key), std::move(cold)...);
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status insert_end(Key key, Cold... cold)
+	{
+		if (tail_ == nullptr || tail_->begin + tail_->count == B)
+		{
+			block * b = make_block(0);
+			if (b == nullptr)
+				return list_status::overflow;
+			link_before(nullptr, b);
+		}
+		put(tail_, tail_->begin + tail_->count++, std::move(key), std::move(cold)...);
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status delete_beg()
+	{
+		if (head_ == nullptr)
+			return list_status::underflow;
+		head_->begin++;
+		if (--head_->count == 0)
+			unlink(head_);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_end()
+	{
+		if (tail_ == nullptr)
+			return list_status::underflow;
+		if (--tail_->count == 0)
+			unlink(tail_);
+		len_--;
+		return list_status::ok;
+	}
+
+	// 1-based position like searching_sll, or 0 when absent. Reads keys only.
+	std::size_t search(const Key & key) const
+	{
+		std::size_t base = 0;
+		for (block * b = head_; b != nullptr; b = b->next)
+		{
+			std::size_t i = find_first(static_cast<const Key *>(b->keys + b->begin), b->count, key);
+			if (i < b->count)
+				return base + i + 1;
+			base += b->count;
+		}
+		return 0;
+	}
+
+	// Reads keys only.
+	template <class P>
+	std::size_t count_if(P pred) const
+	{
+		std::size_t n = 0;
+		for (block * b = head_; b != nullptr; b = b->next)
+		{
+			const Key * k = b->keys + b->begin;
+			for (std::uint32_t i = 0; i < b->count; i++)
+				n += pred(k[i]) ? 1 : 0;
+		}
+		return n;
+	}
+
+	// pred sees only the key; f gets a row view for matches.
+	template <class P, class F>
+	void for_each_match(P pred, F && f)
+	{
+		match<row>(head_, pred, f);
+	}
+
+	template <class P, class F>
+	void for_each_match(P pred, F && f) const
+	{
+		match<const_row>(head_, pred, f);
+	}
+
+	template <class F>
+	void for_each(F && f)
+	{
+		match<row>(head_, [](const Key &) { return true; }, f);
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		match<const_row>(head_, [](const Key &) { return true; }, f);
+	}
+
+	// f(const Key * keys, std::size_t count) once per block, for array kernels.
+	template <class F>
+	void for_each_key_block(F && f) const
+	{
+		for (block * b = head_; b != nullptr; b = b->next)
+			f(static_cast<const Key *>(b->keys + b->begin), std::size_t(b->count));
+	}
+
+	void clear()
+	{
+		while (head_ != nullptr)
+			unlink(head_);
+		len_ = 0;
+	}
+
+private:
+	template <class Row, class P, class F>
+	static void match(block * b, P pred, F & f)
+	{
+		for (; b != nullptr; b = b->next)
+		{
+			std::uint32_t end = b->begin + b->count;
+			for (std::uint32_t i = b->begin; i < end; i++)
+				if (pred(std::as_const(b->keys[i])))
+					f(Row(b, i));
+		}
+	}
+
+	template <std::size_t... I>
+	static void put_cold(block * b, std::uint32_t i, std::tuple<Cold...> && c, std::index_sequence<I...>)
+	{
+		((std::get<I>(b->cold)[i] = std::move(std::get<I>(c))), ...);
+	}
+
+	static void put(block * b, std::uint32_t i, Key && key, Cold &&... cold)
+	{
+		b->keys[i] = std::move(key);
+		put_cold(b, i, std::tuple<Cold...>(std::move(cold)...), std::index_sequence_for<Cold...>());
+	}
+
+	block * make_block(std::uint32_t begin)
+	{
+		void * p;
+		try
+		{
+			p = mr_->allocate(sizeof(block), alignof(block));
+		}
+		catch (const std::bad_alloc &)
+		{
+			return nullptr;
+		}
+		block * b = ::new (p) block;
+		b->begin = begin;
+		b->count = 0;
+		return b;
+	}
+
+	void link_before(block * at, block * b)
+	{
+		b->next = at;
+		b->prev = at ? at->prev : tail_;
+		(b->prev ? b->prev->next : head_) = b;
+		(at ? at->prev : tail_) = b;
+	}
+
+	void unlink(block * b)
+	{
+		(b->prev ? b->prev->next : head_) = b->next;
+		(b->next ? b->next->prev : tail_) = b->prev;
+		b->~block();
+		mr_->deallocate(b, sizeof(block), alignof(block));
+	}
+
+	std::pmr::memory_resource * mr_;
+	block * head_ = nullptr;
+	block * tail_ = nullptr;
+	std::size_t len_ = 0;
+};
+
+} // namespace dsa
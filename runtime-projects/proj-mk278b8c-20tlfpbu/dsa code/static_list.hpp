@@ -0,0 +1,489 @@
+// Fixed-capacity list shapes with no heap use.
+//
+// Nodes live in an array inside the object and are linked by index.
+// Free slots are recycled through an index free list; never-used slots are
+// handed out from a watermark, so construction is O(1). A full list returns
+// list_status::overflow where the C programs would malloc or print.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "list_traits.hpp"
+
+namespace dsa {
+
+// Smallest unsigned type that can hold 0..Cap (Cap itself is the NIL index).
+template <std::size_t Cap>
+using static_index_t = std::conditional_t<(Cap < 0xFFu), std::uint8_t,
+	std::conditional_t<(Cap < 0xFFFFu), std::uint16_t, std::uint32_t>>;
+
+namespace static_detail {
+
+// Slot storage + free list shared by the linked shapes.
+template <class Slot, std::size_t Cap>
+class slot_pool
+{
+public:
+	using index = static_index_t<Cap>;
+	static constexpr index nil = index(Cap);
+
+	bool full() const { return free_ == nil && fresh_ == Cap; }
+
+	index take()
+	{
+		if (free_ != nil)
+		{
+			index i = free_;
+			free_ = slots_[i].link_free;
+			return i;
+		}
+		return fresh_ < Cap ? index(fresh_++) : nil;
+	}
+
+	void give(index i)
+	{
+		slots_[i].link_free = free_;
+		free_ = i;
+	}
+
+	void clear()
+	{
+		free_ = nil;
+		fresh_ = 0;
+	}
+
+	Slot & operator[](index i) { return slots_[i]; }
+	const Slot & operator[](index i) const { return slots_[i]; }
+
+private:
+	Slot slots_[Cap];
+	index free_ = nil;
+	std::size_t fresh_ = 0;
+};
+
+} // namespace static_detail
+
+// Singly linked list (menu_linked.c shape) with head and tail indices, so
+// insert_end is O(1). delete_end still walks, as a singly linked list must.
+template <class T, std::size_t Cap>
+class static_sll
+{
+	using index = static_index_t<Cap>;
+	struct slot
+	{
+		T info;
+		index link_free; // next node, or next free slot when free
+	};
+
+public:
+	static constexpr std::size_t capacity = Cap;
+	static constexpr index nil = index(Cap);
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+
+	list_status insert_beg(const T & item)
+	{
+		index n = pool_.take();
+		if (n == nil)
+			return list_status::overflow;
+		pool_[n].info = item;
+		pool_[n].link_free = head_;
+		head_ = n;
+		if (tail_ == nil)
+			tail_ = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status insert_end(const T & item)
+	{
+		index n = pool_.take();
+		if (n == nil)
+			return list_status::overflow;
+		pool_[n].info = item;
+		pool_[n].link_free = nil;
+		if (tail_ == nil)
+			head_ = n;
+		else
+			pool_[tail_].link_free = n;
+		tail_ = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status delete_beg(T * out = nullptr)
+	{
+		if (head_ == nil)
+			return list_status::underflow;
+		index n = head_;
+		if (out)
+			*out = pool_[n].info;
+		head_ = pool_[n].link_free;
+		if (head_ == nil)
+			tail_ = nil;
+		pool_.give(n);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_end(T * out = nullptr)
+	{
+		if (head_ == nil)
+			return list_status::underflow;
+		if (head_ == tail_)
+			return delete_beg(out);
+		index prev = head_;
+		while (pool_[prev].link_free != tail_)
+			prev = pool_[prev].link_free;
+		if (out)
+			*out = pool_[tail_].info;
+		pool_.give(tail_);
+		pool_[prev].link_free = nil;
+		tail_ = prev;
+		len_--;
+		return list_status::ok;
+	}
+
+	// 1-based position like searching_sll, or 0 when absent.
+	std::size_t search(const T & item) const
+	{
+		std::size_t loc = 1;
+		for (index i = head_; i != nil; i = pool_[i].link_free, loc++)
+			if (pool_[i].info == item)
+				return loc;
+		return 0;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (index i = head_; i != nil; i = pool_[i].link_free)
+			f(pool_[i].info);
+	}
+
+	void clear()
+	{
+		pool_.clear();
+		head_ = tail_ = nil;
+		len_ = 0;
+	}
+
+private:
+	static_detail::slot_pool<slot, Cap> pool_;
+	index head_ = nil, tail_ = nil;
+	std::size_t len_ = 0;
+};
+
+// Doubly linked list (menu_DLL.c shape): every end op is O(1).
+template <class T, std::size_t Cap>
+class static_dll
+{
+	using index = static_index_t<Cap>;
+	struct slot
+	{
+		T info;
+		index prev;
+		index link_free; // next node, or next free slot when free
+	};
+
+public:
+	static constexpr std::size_t capacity = Cap;
+	static constexpr index nil = index(Cap);
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+
+	list_status insert_beg(const T & item) { return link_after(nil, item); }
+	list_status insert_end(const T & item) { return link_after(tail_, item); }
+
+	// Inserts so the item becomes node number `loc` (1-based), like insert_LOC.
+	list_status insert_loc(const T & item, std::size_t loc)
+	{
+		if (loc == 0 || loc > len_ + 1)
+			return list_status::not_found;
+		index prev = nil;
+		for (std::size_t i = 1; i < loc; i++)
+			prev = prev == nil ? head_ : pool_[prev].link_free;
+		return link_after(prev, item);
+	}
+
+	list_status delete_beg(T * out = nullptr) { return unlink(head_, out); }
+	list_status delete_end(T * out = nullptr) { return unlink(tail_, out); }
+
+	std::size_t search(const T & item) const
+	{
+		std::size_t loc = 1;
+		for (index i = head_; i != nil; i = pool_[i].link_free, loc++)
+			if (pool_[i].info == item)
+				return loc;
+		return 0;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (index i = head_; i != nil; i = pool_[i].link_free)
+			f(pool_[i].info);
+	}
+
+	template <class F>
+	void for_each_reverse(F && f) const
+	{
+		for (index i = tail_; i != nil; i = pool_[i].prev)
+			f(pool_[i].info);
+	}
+
+	void clear()
+	{
+		pool_.clear();
+		head_ = tail_ = nil;
+		len_ = 0;
+	}
+
+private:
+	list_status link_after(index prev, const T & item)
+	{
+		index n = pool_.take();
+		if (n == nil)
+			return list_status::overflow;
+		index next = prev == nil ? head_ : pool_[prev].link_free;
+		pool_[n].info = item;
+		pool_[n].prev = prev;
+		pool_[n].link_free = next;
+		(prev == nil ? head_ : pool_[prev].link_free) = n;
+		(next == nil ? tail_ : pool_[next].prev) = n;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status unlink(index n, T * out)
+	{
+		if (n == nil)
+			return list_status::underflow;
+		if (out)
+			*out = pool_[n].info;
+		index prev = pool_[n].prev, next = pool_[n].link_free;
+		(prev == nil ? head_ : pool_[prev].link_free) = next;
+		(next == nil ? tail_ : pool_[next].prev) = prev;
+		pool_.give(n);
+		len_--;
+		return list_status::ok;
+	}
+
+	static_detail::slot_pool<slot, Cap> pool_;
+	index head_ = nil, tail_ = nil;
+	std::size_t len_ = 0;
+};
+
+// Circular singly linked list (csll.c shape) kept by its tail index;
+// tail->link is the head, so both inserts and delete_beg are O(1).
+template <class T, std::size_t Cap>
+class static_csll
+{
+	using index = static_index_t<Cap>;
+	struct slot
+	{
+		T info;
+		index link_free;
+	};
+
+public:
+	static constexpr std::size_t capacity = Cap;
+	static constexpr index nil = index(Cap);
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+
+	list_status insert_beg(const T & item) { return link(item, false); }
+	list_status insert_end(const T & item) { return link(item, true); }
+
+	list_status delete_beg(T * out = nullptr)
+	{
+		if (tail_ == nil)
+			return list_status::underflow;
+		index head = pool_[tail_].link_free;
+		if (out)
+			*out = pool_[head].info;
+		if (head == tail_)
+			tail_ = nil;
+		else
+			pool_[tail_].link_free = pool_[head].link_free;
+		pool_.give(head);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_end(T * out = nullptr)
+	{
+		if (tail_ == nil)
+			return list_status::underflow;
+		if (len_ == 1)
+			return delete_beg(out);
+		index prev = pool_[tail_].link_free;
+		while (pool_[prev].link_free != tail_)
+			prev = pool_[prev].link_free;
+		if (out)
+			*out = pool_[tail_].info;
+		pool_[prev].link_free = pool_[tail_].link_free;
+		pool_.give(tail_);
+		tail_ = prev;
+		len_--;
+		return list_status::ok;
+	}
+
+	// Advances the head by one: the old head becomes the tail.
+	void rotate()
+	{
+		if (tail_ != nil)
+			tail_ = pool_[tail_].link_free;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		if (tail_ == nil)
+			return;
+		index i = tail_;
+		do
+		{
+			i = pool_[i].link_free;
+			f(pool_[i].info);
+		} while (i != tail_);
+	}
+
+	void clear()
+	{
+		pool_.clear();
+		tail_ = nil;
+		len_ = 0;
+	}
+
+private:
+	list_status link(const T & item, bool at_end)
+	{
+		index n = pool_.take();
+		if (n == nil)
+			return list_status::overflow;
+		pool_[n].info = item;
+		if (tail_ == nil)
+		{
+			pool_[n].link_free = n;
+			tail_ = n;
+		}
+		else
+		{
+			pool_[n].link_free = pool_[tail_].link_free;
+			pool_[tail_].link_free = n;
+			if (at_end)
+				tail_ = n;
+		}
+		len_++;
+		return list_status::ok;
+	}
+
+	static_detail::slot_pool<slot, Cap> pool_;
+	index tail_ = nil;
+	std::size_t len_ = 0;
+};
+
+// Stack (linked_stack_menu.c shape). A stack never unlinks from the middle,
+// so a plain array with a top index is the tightest layout.
+template <class T, std::size_t Cap>
+class static_stack
+{
+public:
+	static constexpr std::size_t capacity = Cap;
+
+	std::size_t length() const { return top_; }
+	bool empty() const { return top_ == 0; }
+
+	list_status push(const T & item)
+	{
+		if (top_ == Cap)
+			return list_status::overflow;
+		items_[top_++] = item;
+		return list_status::ok;
+	}
+
+	list_status pop(T * out = nullptr)
+	{
+		if (top_ == 0)
+			return list_status::underflow;
+		--top_;
+		if (out)
+			*out = items_[top_];
+		return list_status::ok;
+	}
+
+	const T * peek() const { return top_ ? &items_[top_ - 1] : nullptr; }
+
+	// Top to bottom, the order peep prints.
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (std::size_t i = top_; i-- > 0;)
+			f(items_[i]);
+	}
+
+	void clear() { top_ = 0; }
+
+private:
+	T items_[Cap];
+	std::size_t top_ = 0;
+};
+
+// Queue (linked_queue_menu.c shape) as a ring buffer over embedded storage.
+template <class T, std::size_t Cap>
+class static_queue
+{
+public:
+	static constexpr std::size_t capacity = Cap;
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+
+	list_status enqueue(const T & item)
+	{
+		if (len_ == Cap)
+			return list_status::overflow;
+		std::size_t rear = front_ + len_;
+		if (rear >= Cap)
+			rear -= Cap;
+		items_[rear] = item;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status dequeue(T * out = nullptr)
+	{
+		if (len_ == 0)
+			return list_status::underflow;
+		if (out)
+			*out = items_[front_];
+		if (++front_ == Cap)
+			front_ = 0;
+		len_--;
+		return list_status::ok;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		std::size_t i = front_;
+		for (std::size_t k = 0; k < len_; k++)
+		{
+			f(items_[i]);
+			if (++i == Cap)
+				i = 0;
+		}
+	}
+
+	void clear() { front_ = len_ = 0; }
+
+private:
+	T items_[Cap];
+	std::size_t front_ = 0, len_ = 0;
+};
+
+} // namespace dsa
@@ -0,0 +1,36 @@
+// Minimal checks shared by the header tests. Each test is one translation
+// unit with its own main, built against the headers one directory up:
+//
+//   g++ -std=c++17 -O2 -pthread -I.. test_list_kernels.cpp && ./a.out
+//
+// A failed CHECK prints the expression and location and marks the run as
+// failed; main returns check_result(), so a nonzero exit means a failure.
+#pragma once
+#include <cstdio>
+
+namespace dsa_test {
+
+inline int & failures()
+{
+	static int n = 0;
+	return n;
+}
+
+inline void fail(const char * expr, const char * file, int line)
+{
+	std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+	failures()++;
+}
+
+inline int check_result(const char * name)
+{
+	if (failures())
+		std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+	else
+		std::printf("%s: ok\n", name);
+	return failures() ? 1 : 0;
+}
+
+} // namespace dsa_test
+
+#define CHECK(expr) ((expr) ? (void)0 : dsa_test::fail(#expr, __FILE__, __LINE__))
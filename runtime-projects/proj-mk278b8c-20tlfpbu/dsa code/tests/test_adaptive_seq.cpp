@@ -0,0 +1,130 @@
+// adaptive_seq against a std::deque through workload phases that drive it
+// from array to unrolled to indexed and back; search must give the first
+// occurrence in every form, and contents must survive every migration.
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "adaptive_seq.hpp"
+#include "check.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 3;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+template <class S>
+bool same(const S & s, const std::deque<int> & m)
+{
+	std::vector<int> v;
+	s.for_each([&](int x) { v.push_back(x); });
+	return v.size() == m.size() && std::equal(v.begin(), v.end(), m.begin());
+}
+
+template <class S>
+void check_search(S & s, const std::deque<int> & m, int key)
+{
+	auto at = std::find(m.begin(), m.end(), key);
+	CHECK(s.search(key) == (at == m.end() ? 0 : std::size_t(at - m.begin()) + 1));
+}
+
+} // namespace
+
+int main()
+{
+	using dsa::seq_form;
+	using st = dsa::list_status;
+	dsa::adaptive_seq<int, 16> s;
+	std::deque<int> m;
+	CHECK(s.form() == seq_form::array && s.delete_beg() == st::underflow);
+
+	// Growth at both ends: too big and too front-heavy for an array.
+	for (int i = 0; i < 5000; i++)
+	{
+		int v = int(rnd() % 300); // plenty of duplicates
+		if (i % 2)
+		{
+			s.insert_beg(v);
+			m.push_front(v);
+		}
+		else
+		{
+			s.insert_end(v);
+			m.push_back(v);
+		}
+	}
+	CHECK(s.form() == seq_form::unrolled && s.stats().to_unrolled == 1);
+	CHECK(same(s, m));
+
+	// Search-heavy phase with churn at the ends: indexed.
+	for (int i = 0; i < 20000; i++)
+	{
+		int r = int(rnd() % 10);
+		int v = int(rnd() % 320);
+		if (r < 7)
+			check_search(s, m, v);
+		else if (r == 7)
+		{
+			s.insert_beg(v);
+			m.push_front(v);
+		}
+		else if (r == 8)
+		{
+			int out = -1;
+			CHECK(s.delete_beg(&out) == st::ok && out == m.front());
+			m.pop_front();
+		}
+		else
+		{
+			int out = -1;
+			CHECK(s.delete_end(&out) == st::ok && out == m.back());
+			m.pop_back();
+		}
+	}
+	CHECK(s.form() == seq_form::indexed && s.stats().to_indexed >= 1);
+	CHECK(same(s, m));
+
+	// Reorders rebuild in place and keep the index in step.
+	s.sort();
+	std::stable_sort(m.begin(), m.end());
+	CHECK(same(s, m));
+	for (int v = 0; v < 320; v += 7)
+		check_search(s, m, v);
+	s.reverse();
+	std::reverse(m.begin(), m.end());
+	CHECK(same(s, m));
+	for (int v = 0; v < 320; v += 7)
+		check_search(s, m, v);
+
+	// Shrink with end ops only: the index is dropped, then the list is small
+	// enough for an array again.
+	while (m.size() > 20)
+	{
+		CHECK(s.delete_end() == st::ok);
+		m.pop_back();
+	}
+	for (int i = 0; i < 4000; i++)
+	{
+		s.insert_end(i);
+		s.delete_end();
+	}
+	CHECK(s.form() == seq_form::array && same(s, m));
+
+	// Forced migrations keep contents and count the items moved.
+	const std::size_t moved = s.stats().migrated_items;
+	for (seq_form f : {seq_form::indexed, seq_form::unrolled, seq_form::array})
+	{
+		s.migrate(f);
+		CHECK(s.form() == f && same(s, m) && s.length() == m.size());
+		check_search(s, m, m.back());
+	}
+	CHECK(s.stats().migrated_items == moved + 3 * m.size());
+	s.migrate(seq_form::array); // already there: not a migration
+	CHECK(s.stats().migrated_items == moved + 3 * m.size());
+
+	return dsa_test::check_result("adaptive_seq");
+}
@@ -0,0 +1,63 @@
+// Snapshot search, indexed and not, against a linear scan: first
+// occurrence of duplicates, absent keys below, between and above the
+// stored ones, and freeze/thaw round trips.
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "check.hpp"
+#include "frozen_list.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 3;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+std::size_t scan(const std::vector<int> & v, int key)
+{
+	auto it = std::find(v.begin(), v.end(), key);
+	return it == v.end() ? 0 : std::size_t(it - v.begin()) + 1;
+}
+
+} // namespace
+
+int main()
+{
+	// Every size through a few complete tree levels, with duplicates.
+	for (std::size_t n = 0; n <= 70; n++)
+	{
+		std::vector<int> v(n);
+		for (int & x : v)
+			x = int(rnd() % 40) * 2; // even keys, so odd ones are absent
+		dsa::frozen_list<int> idx(v, true), lin(v, false);
+		CHECK(idx.indexed() && (n == 0 || !lin.indexed()));
+		for (int key = -3; key <= 83; key++)
+		{
+			CHECK(idx.search(key) == scan(v, key));
+			CHECK(lin.search(key) == scan(v, key));
+		}
+	}
+
+	// freeze() empties the list and keeps order; thaw() rebuilds it.
+	dsa::sll<int> list;
+	for (int i = 0; i < 100; i++)
+		list.insert_end((i * 37) % 101);
+	dsa::frozen_list<int> f = dsa::freeze(list);
+	CHECK(list.empty() && f.length() == 100);
+	CHECK(f[0] == 0 && f[1] == 37 && f.search(37) == 2 && f.search(64) == 0); // 64 is i = 100
+	std::vector<int> seen;
+	f.traversal([&](int x) { seen.push_back(x); });
+	CHECK(seen.size() == 100 && seen[99] == (99 * 37) % 101);
+	list = dsa::thaw(std::move(f));
+	CHECK(list.length() == 100 && list.head()->info == 0 && list.tail()->info == (99 * 37) % 101);
+
+	// freeze_chain copies a C-style chain without touching it.
+	dsa::sll_node<int> c{5, nullptr}, b{3, &c}, a{5, &b};
+	dsa::frozen_list<int> fc = dsa::freeze_chain(&a);
+	CHECK(fc.length() == 3 && fc.search(5) == 1 && fc.search(3) == 2 && a.link == &b);
+
+	return dsa_test::check_result("frozen_list");
+}
@@ -0,0 +1,133 @@
+// Gap buffer edits at random positions against a std::vector model,
+// including growth with the gap in the middle, cursor clamping, reuse of a
+// moved-from buffer, and every array returned to the resource.
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+#include "gap_buffer.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 11;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+std::vector<int> contents(const dsa::gap_buffer<int> & g)
+{
+	std::vector<int> v;
+	g.traverse([&](int x) { v.push_back(x); });
+	return v;
+}
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+	long live = 0;
+
+private:
+	void * do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		live++;
+		return std::pmr::new_delete_resource()->allocate(bytes, align);
+	}
+	void do_deallocate(void * p, std::size_t bytes, std::size_t align) override
+	{
+		live--;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+	}
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+};
+
+} // namespace
+
+int main()
+{
+	using st = dsa::list_status;
+	counting_resource mr;
+	{
+		dsa::gap_buffer<int> g(1, &mr); // starts tiny so growth happens often
+		std::vector<int> m;
+		for (int step = 0; step < 20000; step++)
+		{
+			int item = int(rnd() % 1000), out = -1;
+			std::size_t at = m.empty() ? 0 : rnd() % (m.size() + 1);
+			switch (rnd() % 6)
+			{
+			case 0:
+			case 1:
+				CHECK(g.insert_at(at, item) == st::ok);
+				m.insert(m.begin() + std::ptrdiff_t(at), item);
+				CHECK(g.cursor() == at + 1);
+				break;
+			case 2:
+				CHECK(g.delete_at(at, &out) == (at < m.size() ? st::ok : st::underflow));
+				if (at < m.size())
+				{
+					CHECK(out == m[at]);
+					m.erase(m.begin() + std::ptrdiff_t(at));
+				}
+				break;
+			case 3:
+				// Typing then backspacing at the cursor.
+				g.move_cursor(at);
+				CHECK(g.insert(item) == st::ok && g.insert(item + 1) == st::ok);
+				CHECK(g.erase_before(&out) == st::ok && out == item + 1);
+				m.insert(m.begin() + std::ptrdiff_t(at), item);
+				break;
+			case 4:
+				CHECK(g.delete_beg(&out) == (m.empty() ? st::underflow : st::ok));
+				if (!m.empty())
+				{
+					CHECK(out == m.front());
+					m.erase(m.begin());
+				}
+				break;
+			case 5:
+				CHECK(g.delete_end(&out) == (m.empty() ? st::underflow : st::ok));
+				if (!m.empty())
+				{
+					CHECK(out == m.back());
+					m.pop_back();
+				}
+				break;
+			}
+			CHECK(g.length() == m.size());
+			if (step % 61 == 0)
+			{
+				CHECK(contents(g) == m);
+				for (std::size_t i = 0; i < m.size(); i += 7)
+					CHECK(g[i] == m[i]);
+			}
+		}
+
+		CHECK(mr.live == 1 && g.resource() == &mr);
+
+		// A moved-from buffer is empty and grows again from nothing.
+		dsa::gap_buffer<int> taken(std::move(g));
+		CHECK(contents(taken) == m && g.empty() && g.length() == 0);
+		for (int i = 0; i < 100; i++)
+			CHECK(g.insert_end(i) == st::ok);
+		CHECK(g.length() == 100 && g.capacity() >= 100 && g[0] == 0 && g[99] == 99);
+		CHECK(g.delete_beg() == st::ok && g.length() == 99 && g[0] == 1);
+		CHECK(mr.live == 2);
+	}
+	CHECK(mr.live == 0);
+
+	// Positions past the end.
+	dsa::gap_buffer<int> h;
+	CHECK(h.insert_at(1, 5) == st::not_found && h.insert_loc(5, 0) == st::not_found);
+	CHECK(h.insert_loc(1, 1) == st::ok && h.insert_loc(3, 2) == st::ok && h.insert_loc(2, 2) == st::ok);
+	CHECK((contents(h) == std::vector<int>{1, 2, 3}));
+	h.move_cursor(100);
+	CHECK(h.cursor() == 3);
+	CHECK(h.erase_after() == st::underflow && h.delete_at(3) == st::underflow);
+	h.clear();
+	CHECK(h.empty() && h.erase_before() == st::underflow);
+
+	return dsa_test::check_result("gap_buffer");
+}
@@ -0,0 +1,116 @@
+// Handles stay bound to their item through erase's hole filling and
+// compact(), and go stale (never aliasing a reused slot) once erased.
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+#include "handle_list.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 5;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+using model = std::list<std::pair<dsa::handle, int>>;
+
+void check_same(const dsa::handle_list<int> & l, const model & m)
+{
+	CHECK(l.length() == m.size());
+	std::vector<int> got, want;
+	l.for_each([&](int x) { got.push_back(x); });
+	for (const auto & e : m)
+	{
+		want.push_back(e.second);
+		const int * p = l.resolve(e.first);
+		CHECK(p != nullptr && *p == e.second);
+	}
+	CHECK(got == want);
+	// The handle walk agrees with the model in both directions.
+	auto it = m.begin();
+	for (dsa::handle h = l.head(); !h.null(); h = l.next(h), ++it)
+		CHECK(it != m.end() && h == it->first);
+	CHECK(it == m.end());
+	auto rit = m.rbegin();
+	for (dsa::handle h = l.tail(); !h.null(); h = l.prev(h), ++rit)
+		CHECK(rit != m.rend() && h == rit->first);
+}
+
+} // namespace
+
+int main()
+{
+	using st = dsa::list_status;
+	dsa::handle_list<int> l;
+	model m;
+	std::vector<dsa::handle> dead;
+	for (int step = 0; step < 8000; step++)
+	{
+		int item = step;
+		unsigned op = rnd() % 7;
+		if (op == 0)
+			m.emplace_front(l.insert_beg(item), item);
+		else if (op == 1)
+			m.emplace_back(l.insert_end(item), item);
+		else if (op <= 3 && !m.empty())
+		{
+			auto at = std::next(m.begin(), std::ptrdiff_t(rnd() % m.size()));
+			dsa::handle h = l.insert_after(at->first, item);
+			m.emplace(std::next(at), h, item);
+		}
+		else if (op <= 5 && !m.empty())
+		{
+			auto at = std::next(m.begin(), std::ptrdiff_t(rnd() % m.size()));
+			int out = -1;
+			CHECK(l.erase(at->first, &out) == st::ok && out == at->second);
+			dead.push_back(at->first);
+			m.erase(at);
+		}
+		else if (op == 6)
+			l.compact();
+		if (step % 89 == 0)
+		{
+			check_same(l, m);
+			for (dsa::handle h : dead)
+				CHECK(!l.valid(h) && l.resolve(h) == nullptr);
+		}
+	}
+	check_same(l, m);
+
+	// Stale handles: erasing twice and inserting after one do nothing.
+	CHECK(!dead.empty());
+	CHECK(l.erase(dead[0]) == st::not_found);
+	CHECK(l.insert_after(dead[0], 1).null());
+	CHECK(!l.valid(dsa::handle()));
+
+	// End deletes follow the list, not the array.
+	dsa::handle_list<int> e;
+	CHECK(e.delete_beg() == st::underflow && e.delete_end() == st::underflow);
+	dsa::handle b = e.insert_end(2);
+	e.insert_beg(1);
+	e.insert_end(3);
+	int out = 0;
+	CHECK(e.delete_beg(&out) == st::ok && out == 1);
+	CHECK(e.delete_end(&out) == st::ok && out == 3);
+	CHECK(*e.resolve(b) == 2);
+
+	// clear() retires every handle.
+	std::vector<dsa::handle> live;
+	for (const auto & p : m)
+		live.push_back(p.first);
+	l.clear();
+	CHECK(l.empty());
+	for (dsa::handle h : live)
+		CHECK(!l.valid(h));
+	dsa::handle fresh = l.insert_end(42);
+	CHECK(*l.resolve(fresh) == 42);
+	for (dsa::handle h : live)
+		CHECK(l.resolve(h) == nullptr);
+
+	return dsa_test::check_result("handle_list");
+}
@@ -0,0 +1,139 @@
+// Region and scope release: blocks go back to the arena without touching
+// nodes, are reused before upstream is asked again, small slots are
+// recycled within a region, and the arena returns everything upstream.
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+#include "check.hpp"
+#include "list_arena.hpp"
+#include "list_engine.hpp"
+
+namespace {
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+	long live = 0;
+	long calls = 0;
+
+private:
+	void * do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		live++;
+		calls++;
+		return std::pmr::new_delete_resource()->allocate(bytes, align);
+	}
+	void do_deallocate(void * p, std::size_t bytes, std::size_t align) override
+	{
+		live--;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+	}
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+};
+
+} // namespace
+
+int main()
+{
+	counting_resource up;
+	{
+		dsa::list_arena arena(&up);
+
+		// A region spanning several blocks, released in one step.
+		dsa::arena_region * r = arena.make_region();
+		{
+			dsa::sll<int> l(r);
+			for (int i = 0; i < 20000; i++) // 16-byte nodes: ~5 blocks
+				l.insert_end(i);
+			long sum = 0;
+			l.for_each([&](int x) { sum += x; });
+			CHECK(sum == 19999L * 20000 / 2);
+			l.abandon();
+		}
+		const std::size_t mapped = arena.stats().blocks_mapped;
+		CHECK(mapped >= 5 && arena.stats().regions_open == 1);
+		r->release();
+		CHECK(arena.stats().blocks_free == mapped && arena.stats().regions_open == 0);
+		CHECK(arena.stats().region_releases == 1);
+
+		// The same work again maps nothing new.
+		const long calls = up.calls;
+		r = arena.make_region();
+		{
+			dsa::sll<int> l(r);
+			for (int i = 0; i < 20000; i++)
+				l.insert_end(i);
+			l.abandon();
+		}
+		r->release();
+		CHECK(up.calls == calls && arena.stats().blocks_mapped == mapped);
+
+		// Deleted nodes are reused inside the region.
+		r = arena.make_region();
+		{
+			dsa::sll<int> l(r);
+			l.insert_end(1);
+			void * first = l.head();
+			l.delete_beg();
+			l.insert_end(2);
+			CHECK(static_cast<void *>(l.head()) == first);
+			std::size_t used = r->bytes_used();
+			l.delete_beg();
+			CHECK(r->bytes_used() < used);
+			l.abandon();
+		}
+
+		// Requests larger than a block get their own block, freed with the region.
+		void * big = r->allocate(3 * dsa::list_arena::block_size, 64);
+		CHECK(reinterpret_cast<std::uintptr_t>(big) % 64 == 0);
+		std::memset(big, 1, 3 * dsa::list_arena::block_size);
+		r->release();
+
+		// Scopes: every region goes pending in O(1), recycled on demand.
+		{
+			dsa::arena_scope scope(arena);
+			std::vector<dsa::sll<int>> lists;
+			for (int k = 0; k < 10; k++)
+			{
+				lists.emplace_back(scope.make_region());
+				for (int i = 0; i < 100; i++)
+					lists.back().insert_end(i);
+			}
+			CHECK(scope.regions() == 10 && arena.stats().regions_open == 10);
+			// One region released early; the scope forgets it.
+			dsa::arena_region * early = static_cast<dsa::arena_region *>(lists[3].resource());
+			lists[3].abandon();
+			early->release();
+			CHECK(scope.regions() == 9);
+			for (dsa::sll<int> & l : lists)
+				l.abandon();
+			scope.release();
+			CHECK(scope.regions() == 0 && arena.stats().regions_open == 0);
+			CHECK(arena.stats().regions_pending == 9 && arena.stats().scope_releases == 1);
+		} // the destructor's release() finds nothing left
+
+		// Draining the free list recycles pending regions before mapping.
+		const std::size_t before = arena.stats().blocks_mapped;
+		const std::size_t reusable = arena.stats().blocks_free + 9;
+		std::vector<dsa::arena_region *> regions;
+		for (std::size_t i = 0; i < reusable; i++)
+			regions.push_back(arena.make_region());
+		CHECK(arena.stats().blocks_mapped == before);
+		CHECK(arena.stats().regions_pending == 0);
+		for (dsa::arena_region * x : regions)
+			x->release();
+
+		arena.shrink();
+		CHECK(arena.stats().blocks_free == 0 && up.live == 0);
+
+		// Regions left pending at destruction are still returned.
+		dsa::arena_scope last(arena);
+		dsa::sll<int> l(last.make_region());
+		l.insert_end(1);
+		l.abandon();
+		last.release();
+	}
+	CHECK(up.live == 0);
+
+	return dsa_test::check_result("list_arena");
+}
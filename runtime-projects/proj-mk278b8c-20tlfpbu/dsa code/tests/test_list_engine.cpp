@@ -0,0 +1,213 @@
+// Owning engine lists: sll and dll against a std::deque model, sort
+// stability, reverse and tail upkeep, allocation failure reported as
+// overflow, and every node returned to the resource.
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+#include "list_engine.hpp"
+
+namespace {
+
+// Counts live blocks; fails allocations once `budget` reaches zero.
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+	long live = 0;
+	long budget = -1; // unlimited
+
+private:
+	void * do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		if (budget == 0)
+			throw std::bad_alloc();
+		if (budget > 0)
+			budget--;
+		live++;
+		return std::pmr::new_delete_resource()->allocate(bytes, align);
+	}
+	void do_deallocate(void * p, std::size_t bytes, std::size_t align) override
+	{
+		live--;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+	}
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+};
+
+std::uint32_t rng_state = 7;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+template <class L>
+std::vector<int> contents(const L & l)
+{
+	std::vector<int> v;
+	l.for_each([&](int x) { v.push_back(x); });
+	return v;
+}
+
+template <class L>
+void check_model(counting_resource & mr)
+{
+	using st = dsa::list_status;
+	L l(&mr);
+	std::deque<int> m;
+	for (int step = 0; step < 5000; step++)
+	{
+		int item = int(rnd() % 100), out = -1;
+		switch (rnd() % 5)
+		{
+		case 0:
+			CHECK(l.insert_beg(item) == st::ok);
+			m.push_front(item);
+			break;
+		case 1:
+		case 2:
+			CHECK(l.insert_end(item) == st::ok);
+			m.push_back(item);
+			break;
+		case 3:
+			CHECK(l.delete_beg(&out) == (m.empty() ? st::underflow : st::ok));
+			if (!m.empty())
+			{
+				CHECK(out == m.front());
+				m.pop_front();
+			}
+			break;
+		case 4:
+			CHECK(l.delete_end(&out) == (m.empty() ? st::underflow : st::ok));
+			if (!m.empty())
+			{
+				CHECK(out == m.back());
+				m.pop_back();
+			}
+			break;
+		}
+		CHECK(l.length() == m.size());
+		CHECK((l.tail() == nullptr) == m.empty());
+		if (!m.empty())
+			CHECK(l.head()->info == m.front() && l.tail()->info == m.back());
+		if (step % 101 == 0)
+		{
+			CHECK(contents(l) == std::vector<int>(m.begin(), m.end()));
+			std::size_t want = 0;
+			for (std::size_t i = 0; i < m.size() && want == 0; i++)
+				if (m[i] == item)
+					want = i + 1;
+			CHECK(l.search(item) == want);
+		}
+	}
+	CHECK(mr.live == long(m.size()));
+
+	// reverse() and sort() keep tail() on the last node.
+	l.reverse();
+	CHECK(contents(l) == std::vector<int>(m.rbegin(), m.rend()));
+	if (!m.empty())
+		CHECK(l.tail()->info == m.front());
+	l.sort();
+	std::vector<int> sorted(m.begin(), m.end());
+	std::stable_sort(sorted.begin(), sorted.end());
+	CHECK(contents(l) == sorted);
+	if (!sorted.empty())
+		CHECK(l.tail()->info == sorted.back());
+	CHECK(l.insert_end(1000) == st::ok && l.tail()->info == 1000);
+
+	// Moving hands over the nodes without copying.
+	L other(std::move(l));
+	CHECK(l.empty() && other.length() == sorted.size() + 1);
+	l = std::move(other);
+	CHECK(other.empty() && l.length() == sorted.size() + 1);
+	l.clear();
+	CHECK(l.empty() && mr.live == 0);
+
+	// Out of memory: overflow, list unchanged.
+	l.insert_end(1);
+	mr.budget = 0;
+	CHECK(l.insert_beg(2) == st::overflow && l.insert_end(3) == st::overflow);
+	CHECK((contents(l) == std::vector<int>{1}));
+	mr.budget = -1;
+}
+
+} // namespace
+
+int main()
+{
+	counting_resource mr;
+	check_model<dsa::sll<int>>(mr);
+	CHECK(mr.live == 0);
+	check_model<dsa::dll<int>>(mr);
+	CHECK(mr.live == 0);
+
+	// Sort is stable: equal keys keep their insertion order.
+	{
+		dsa::sll<std::pair<int, int>> l(&mr);
+		for (int i = 0; i < 200; i++)
+			l.insert_end({int(rnd() % 5), i});
+		l.sort([](const auto & a, const auto & b) { return a.first < b.first; });
+		std::pair<int, int> prev{-1, -1};
+		l.for_each([&](const std::pair<int, int> & p) {
+			CHECK(prev.first < p.first || (prev.first == p.first && prev.second < p.second));
+			prev = p;
+		});
+	}
+
+	// dll: insert_loc from either end, prev links consistent after sort.
+	{
+		dsa::dll<int> d(&mr);
+		CHECK(d.insert_loc(5, 2) == dsa::list_status::not_found);
+		for (int i = 0; i < 10; i += 2)
+			d.insert_end(i);
+		CHECK(d.insert_loc(1, 2) == dsa::list_status::ok);  // near the head
+		CHECK(d.insert_loc(7, 6) == dsa::list_status::ok);  // near the tail
+		CHECK(d.insert_loc(9, 8) == dsa::list_status::ok);  // append
+		CHECK((contents(d) == std::vector<int>{0, 1, 2, 4, 6, 7, 8, 9}));
+		d.reverse();
+		d.sort();
+		const dsa::dll_node<int> * prev = nullptr;
+		for (const dsa::dll_node<int> * p = d.head(); p; p = p->next)
+		{
+			CHECK(p->prev == prev);
+			prev = p;
+		}
+		CHECK(prev == d.tail());
+	}
+
+	// Non-trivial payloads are destroyed with their nodes.
+	{
+		dsa::sll<std::string> l(&mr);
+		l.insert_end(std::string(100, 'x'));
+		std::string out;
+		CHECK(l.delete_beg(&out) == dsa::list_status::ok && out.size() == 100);
+	}
+
+	// Stack and queue adapters.
+	{
+		dsa::stack<int> s(&mr);
+		dsa::queue<int> q(&mr);
+		int out = 0;
+		CHECK(s.pop(&out) == dsa::list_status::underflow && s.peek() == nullptr);
+		CHECK(q.dequeue(&out) == dsa::list_status::underflow);
+		for (int i = 0; i < 5; i++)
+		{
+			s.push(i);
+			q.enqueue(i);
+		}
+		CHECK(*s.peek() == 4 && q.front()->info == 0 && q.rear()->info == 4);
+		for (int i = 0; i < 5; i++)
+		{
+			CHECK(s.pop(&out) == dsa::list_status::ok && out == 4 - i);
+			CHECK(q.dequeue(&out) == dsa::list_status::ok && out == i);
+		}
+		CHECK(s.empty() && q.empty() && q.rear() == nullptr);
+	}
+	CHECK(mr.live == 0);
+
+	return dsa_test::check_result("list_engine");
+}
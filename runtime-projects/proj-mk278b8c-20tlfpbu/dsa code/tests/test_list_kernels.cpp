@@ -0,0 +1,111 @@
+// find_first and sum against a plain loop, for every integral width,
+// signed and unsigned, and enums of each width, for lengths on both sides
+// of each vector boundary.
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+#include "list_kernels.hpp"
+
+template <class T>
+void check_type()
+{
+	for (std::size_t n = 0; n <= 70; n++)
+	{
+		std::vector<T> v(n);
+		for (std::size_t i = 0; i < n; i++)
+			v[i] = T(i * 7 + 3); // distinct for n <= 70 in every width
+		for (std::size_t i = 0; i < n; i++)
+			CHECK(dsa::find_first(v.data(), n, v[i]) == i);
+		CHECK(dsa::find_first(v.data(), n, T(1)) == n); // 1 is never i*7+3 mod 256
+
+		std::int64_t want = 0;
+		for (T x : v)
+			want += std::int64_t(x);
+		if constexpr (std::is_signed_v<T>)
+		{
+			for (std::size_t i = 0; i < n; i += 3)
+				v[i] = T(-v[i]);
+			want = 0;
+			for (T x : v)
+				want += std::int64_t(x);
+		}
+		CHECK(dsa::sum(v.data(), n) == want);
+
+		// Top-of-range items: a signed lane reading would go negative.
+		if constexpr (std::is_unsigned_v<T>)
+		{
+			want = 0;
+			for (std::size_t i = 0; i < n; i++)
+			{
+				v[i] = T(std::numeric_limits<T>::max() - T(i % 5));
+				want = std::int64_t(std::uint64_t(want) + std::uint64_t(v[i]));
+			}
+			CHECK(dsa::sum(v.data(), n) == want);
+		}
+	}
+
+	// The first match wins when the key repeats.
+	std::vector<T> dup(40, T(5));
+	dup[17] = T(9);
+	dup[33] = T(9);
+	CHECK(dsa::find_first(dup.data(), dup.size(), T(9)) == 17);
+}
+
+enum class code8 : std::uint8_t {};
+enum class code16 : std::int16_t {};
+enum code32 : std::uint32_t {};
+enum class code64 : std::int64_t {};
+
+template <class E>
+void check_enum()
+{
+	using U = std::underlying_type_t<E>;
+	for (std::size_t n = 0; n <= 70; n++)
+	{
+		std::vector<E> v(n);
+		for (std::size_t i = 0; i < n; i++)
+			v[i] = E(U(i * 7 + 3));
+		for (std::size_t i = 0; i < n; i++)
+			CHECK(dsa::find_first(v.data(), n, v[i]) == i);
+		CHECK(dsa::find_first(v.data(), n, E(U(1))) == n);
+	}
+	std::vector<E> dup(40, E(U(200)));
+	dup[21] = E(U(9));
+	dup[30] = E(U(9));
+	CHECK(dsa::find_first(dup.data(), dup.size(), E(U(9))) == 21);
+}
+
+int main()
+{
+	check_type<char>();
+	check_type<signed char>();
+	check_type<unsigned char>();
+	check_type<short>();
+	check_type<unsigned short>();
+	check_type<int>();
+	check_type<unsigned>();
+	check_type<long>();
+	check_type<unsigned long>();
+	check_type<long long>();
+	check_type<unsigned long long>();
+	check_type<std::int8_t>();
+	check_type<std::int16_t>();
+	check_type<std::int32_t>();
+	check_type<std::int64_t>();
+	check_type<std::uint8_t>();
+	check_type<std::uint16_t>();
+	check_type<std::uint32_t>();
+	check_type<std::uint64_t>();
+	check_enum<code8>();
+	check_enum<code16>();
+	check_enum<code32>();
+	check_enum<code64>();
+
+	// The case that regressed: plain char took the int32 compare.
+	const char buf[32] = {'a', 'b', 'c'};
+	CHECK(dsa::find_first(buf, 32, 'c') == 2);
+
+	return dsa_test::check_result("list_kernels");
+}
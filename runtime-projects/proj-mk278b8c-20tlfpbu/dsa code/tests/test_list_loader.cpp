@@ -0,0 +1,106 @@
+// load_list on a file large enough to be cut into several parts: items
+// arrive in file order after what the list already held, bad tokens are
+// counted and skipped, a missing file leaves the list alone, and a list
+// whose resource is not a node_pool gets the same result.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "check.hpp"
+#include "list_loader.hpp"
+
+namespace {
+
+std::vector<int> contents(const dsa::sll<int> & l)
+{
+	std::vector<int> v;
+	l.for_each([&](int x) { v.push_back(x); });
+	return v;
+}
+
+} // namespace
+
+int main()
+{
+	using st = dsa::list_status;
+	char path[] = "/tmp/dsa_loader_XXXXXX";
+	int fd = mkstemp(path);
+	CHECK(fd >= 0);
+	std::FILE * f = fdopen(fd, "w");
+
+	// Mixed separators and bad tokens; ~4 MiB so it spans several parts.
+	std::vector<int> want{-1, 2}; // already in the list
+	std::size_t bad = 0;
+	std::uint32_t x = 9;
+	for (int i = 0; i < 500000; i++)
+	{
+		x = x * 1664525u + 1013904223u;
+		int v = int(x >> 1) - (1 << 30);
+		want.push_back(v);
+		std::fprintf(f, i % 7 == 0 ? "%d\t" : i % 3 == 0 ? "%+d " : "%d\n", v);
+		if (i % 50000 == 0)
+		{
+			std::fputs(" 12x 99999999999 + -\n", f); // all four rejected
+			bad += 4;
+		}
+	}
+	std::fputs("123", f); // last token with no newline after it
+	want.push_back(123);
+	std::fclose(f);
+
+	dsa::thread_pool workers(3);
+	{
+		dsa::node_pool pool(sizeof(dsa::sll_node<int>), alignof(dsa::sll_node<int>));
+		dsa::sll<int> list(&pool);
+		list.insert_end(-1);
+		list.insert_end(2);
+		dsa::load_stats stats;
+		CHECK(dsa::load_list(path, list, workers, &stats) == st::ok);
+		CHECK(stats.parts > 1 && stats.parts <= workers.size() + 1);
+		CHECK(stats.items == want.size() - 2 && stats.rejected == bad);
+		CHECK(list.length() == want.size());
+		CHECK(contents(list) == want);
+		CHECK(pool.stats().live_nodes == want.size()); // part pools were adopted
+
+		// The list still works as a list afterwards.
+		CHECK(list.insert_end(7) == st::ok && list.delete_end() == st::ok);
+		CHECK(list.search(123) == want.size());
+
+		CHECK(dsa::load_list("/nonexistent/dsa_loader", list, workers, &stats) == st::not_found);
+		CHECK(list.length() == want.size());
+	}
+	{
+		dsa::sll<int> list; // default resource: parsed in parallel, linked here
+		list.insert_end(-1);
+		list.insert_end(2);
+		dsa::load_stats stats;
+		CHECK(dsa::load_list(path, list, workers, &stats) == st::ok);
+		CHECK(stats.items == want.size() - 2 && stats.rejected == bad);
+		CHECK(contents(list) == want);
+	}
+	{
+		// Narrower items: values that do not fit are rejected, not truncated.
+		dsa::sll<std::int16_t> list;
+		dsa::load_stats stats;
+		CHECK(dsa::load_list(path, list, workers, &stats) == st::ok);
+		std::size_t fit = 0;
+		for (std::size_t i = 2; i < want.size(); i++)
+			fit += want[i] >= INT16_MIN && want[i] <= INT16_MAX;
+		CHECK(list.length() == fit && stats.rejected == bad + (want.size() - 2 - fit));
+	}
+
+	// An empty file loads nothing and succeeds.
+	f = std::fopen(path, "w");
+	std::fclose(f);
+	{
+		dsa::sll<int> list;
+		dsa::load_stats stats;
+		CHECK(dsa::load_list(path, list, workers, &stats) == st::ok);
+		CHECK(list.empty() && stats.items == 0 && stats.bytes == 0);
+	}
+	unlink(path);
+
+	return dsa_test::check_result("list_loader");
+}
@@ -0,0 +1,82 @@
+// Segment discovery, and parallel map/reduce/filter checked against a
+// serial walk on SLL and DLL chains.
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "list_parallel.hpp"
+
+template <class N>
+std::vector<int> items(N * start)
+{
+	std::vector<int> v;
+	for (N * p = start; p != nullptr; p = dsa::next_of(p))
+		v.push_back(dsa::value_of(p));
+	return v;
+}
+
+int main()
+{
+	dsa::thread_pool pool(3);
+
+	// Marks start at the head, are in list order, and number 1..2*parts.
+	for (std::size_t n : {1, 2, 7, 64, 1000, 4097})
+		for (std::size_t parts : {1, 2, 4, 8})
+		{
+			std::vector<dsa::sll_node<int>> v(n);
+			for (std::size_t i = 0; i < n; i++)
+				v[i] = {int(i), i + 1 < n ? &v[i + 1] : nullptr};
+			std::vector<dsa::sll_node<int> *> marks = dsa::discover_segments(&v[0], parts);
+			CHECK(!marks.empty() && marks.size() <= 2 * parts && marks[0] == &v[0]);
+			for (std::size_t i = 1; i < marks.size(); i++)
+				CHECK(marks[i] > marks[i - 1]);
+			if (n >= 2 * parts)
+				CHECK(marks.size() >= parts); // never collapses below `parts`
+		}
+	CHECK(dsa::discover_segments<dsa::sll_node<int>>(nullptr, 4).empty());
+
+	const int n = 10007;
+	std::vector<dsa::sll_node<int>> sll(n);
+	for (int i = 0; i < n; i++)
+		sll[i] = {i, i + 1 < n ? &sll[i + 1] : nullptr};
+
+	dsa::parallel_map(pool, &sll[0], [](int x) { return x * 2; });
+	long long serial = 0;
+	for (int i = 0; i < n; i++)
+	{
+		CHECK(sll[i].info == 2 * i);
+		serial += sll[i].info;
+	}
+	CHECK(dsa::parallel_reduce(pool, &sll[0], 0LL, [](int x) { return (long long)x; },
+		[](long long a, long long b) { return a + b; }) == serial);
+
+	// Non-commutative op: concatenation must come out in list order.
+	std::vector<dsa::sll_node<int>> digits(200);
+	for (int i = 0; i < 200; i++)
+		digits[i] = {i % 10, i + 1 < 200 ? &digits[i + 1] : nullptr};
+	std::string want;
+	for (int i = 0; i < 200; i++)
+		want += char('0' + i % 10);
+	CHECK(dsa::parallel_reduce(pool, &digits[0], std::string(), [](int d) { return std::string(1, char('0' + d)); },
+		[](std::string a, const std::string & b) { return a + b; }) == want);
+
+	// Filter on a DLL: kept nodes stay in order with prev links repaired.
+	std::vector<dsa::dll_node<int>> dll(n);
+	for (int i = 0; i < n; i++)
+		dll[i] = {i, i ? &dll[i - 1] : nullptr, i + 1 < n ? &dll[i + 1] : nullptr};
+	int dropped = 0;
+	dsa::dll_node<int> * start = dsa::parallel_filter(pool, &dll[0], [](int x) { return x % 3 == 0; },
+		[&](dsa::dll_node<int> *) { dropped++; });
+	std::vector<int> kept = items(start);
+	CHECK(int(kept.size()) == (n + 2) / 3 && dropped == n - int(kept.size()));
+	for (std::size_t i = 0; i < kept.size(); i++)
+		CHECK(kept[i] == int(3 * i));
+	CHECK(start->prev == nullptr);
+	for (dsa::dll_node<int> * p = start; p->next != nullptr; p = p->next)
+		CHECK(p->next->prev == p);
+
+	// Dropping everything leaves an empty list.
+	start = dsa::parallel_filter(pool, start, [](int) { return false; }, [](dsa::dll_node<int> *) {});
+	CHECK(start == nullptr);
+
+	return dsa_test::check_result("list_parallel");
+}
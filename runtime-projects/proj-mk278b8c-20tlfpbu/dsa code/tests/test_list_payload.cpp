@@ -0,0 +1,155 @@
+// inline_string bounds and flex_sll against a std::deque of strings:
+// every op, tail kept right through deletes and reverse, and each record
+// freed with the size it was allocated with.
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "check.hpp"
+#include "list_engine.hpp"
+#include "list_payload.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 17;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+// Counts bytes so a deallocation with the wrong size shows up as drift.
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+	long live = 0;
+	long bytes = 0;
+
+private:
+	void * do_allocate(std::size_t n, std::size_t align) override
+	{
+		live++;
+		bytes += long(n);
+		return std::pmr::new_delete_resource()->allocate(n, align);
+	}
+	void do_deallocate(void * p, std::size_t n, std::size_t align) override
+	{
+		live--;
+		bytes -= long(n);
+		std::pmr::new_delete_resource()->deallocate(p, n, align);
+	}
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+};
+
+bool same(const dsa::flex_sll & l, const std::deque<std::string> & m)
+{
+	std::vector<std::string> v;
+	l.for_each([&](std::string_view s) { v.emplace_back(s); });
+	if (v.size() != m.size() || l.length() != m.size())
+		return false;
+	for (std::size_t i = 0; i < v.size(); i++)
+		if (v[i] != m[i])
+			return false;
+	return m.empty() ? l.head() == nullptr && l.tail() == nullptr : l.tail()->view() == m.back();
+}
+
+} // namespace
+
+int main()
+{
+	using st = dsa::list_status;
+
+	// inline_string: stored in the node, bounded, compared by contents.
+	{
+		dsa::inline_string<8> a("abc"), b(std::string_view("abc")), c(3, 'z');
+		CHECK(a == b && a != c && a < c && c.view() == "zzz" && a.size() == 3);
+		CHECK(dsa::inline_string<8>("12345678").size() == 8);
+		const char * none = nullptr;
+		CHECK(dsa::inline_string<8>(none).size() == 0 && dsa::inline_string<8>(none) == dsa::inline_string<8>());
+		CHECK(dsa::inline_string<8>(std::string_view()).view().empty());
+		bool threw = false;
+		try
+		{
+			dsa::inline_string<8> too_long("123456789");
+		}
+		catch (const std::length_error &)
+		{
+			threw = true;
+		}
+		CHECK(threw);
+
+		dsa::sll<dsa::inline_string<24>> l;
+		l.insert_end("one");
+		l.insert_end("two");
+		CHECK(l.search("two") == 2 && l.search("three") == 0);
+	}
+
+	counting_resource mr;
+	{
+		dsa::flex_sll l(&mr);
+		std::deque<std::string> m;
+		CHECK(l.delete_beg() == st::underflow && l.delete_end() == st::underflow);
+		for (int step = 0; step < 5000; step++)
+		{
+			std::string s(rnd() % 40, char('a' + rnd() % 26)); // empty records too
+			switch (rnd() % 7)
+			{
+			case 0:
+			case 1:
+				CHECK(l.insert_beg(s) == st::ok);
+				m.push_front(s);
+				break;
+			case 2:
+			case 3:
+				CHECK(l.insert_end(s) == st::ok);
+				m.push_back(s);
+				break;
+			case 4:
+				CHECK(l.delete_beg() == (m.empty() ? st::underflow : st::ok));
+				if (!m.empty())
+					m.pop_front();
+				break;
+			case 5:
+				CHECK(l.delete_end() == (m.empty() ? st::underflow : st::ok));
+				if (!m.empty())
+					m.pop_back();
+				break;
+			default:
+				l.reverse();
+				m = std::deque<std::string>(m.rbegin(), m.rend());
+				break;
+			}
+			CHECK(same(l, m));
+			if (step % 50 == 0)
+			{
+				std::size_t want = 0;
+				for (std::size_t i = 0; i < m.size() && want == 0; i++)
+					if (m[i] == s)
+						want = i + 1;
+				CHECK(l.search(s) == want);
+			}
+		}
+		CHECK(mr.live == long(m.size()));
+
+		// Moves carry the resource and leave the source empty.
+		dsa::flex_sll moved(std::move(l));
+		CHECK(l.empty() && l.head() == nullptr && same(moved, m));
+		dsa::flex_sll other(&mr);
+		other.insert_end("replaced");
+		other = std::move(moved);
+		CHECK(moved.empty() && same(other, m) && other.resource() == &mr);
+		CHECK(mr.live == long(m.size()));
+
+		// Deleting the only node through delete_end clears tail.
+		other.clear();
+		other.insert_end("x");
+		CHECK(other.delete_end() == st::ok && other.tail() == nullptr);
+		CHECK(other.insert_end("y") == st::ok && other.tail()->view() == "y");
+	}
+	CHECK(mr.live == 0 && mr.bytes == 0);
+
+	return dsa_test::check_result("list_payload");
+}
@@ -0,0 +1,58 @@
+// Fused pipelines over linear and circular chains: results, stage order,
+// and take() ending the walk early.
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "check.hpp"
+#include "list_pipeline.hpp"
+
+int main()
+{
+	// 1..10 as an SLL chain.
+	std::vector<dsa::sll_node<int>> sll(10);
+	for (int i = 0; i < 10; i++)
+		sll[i] = {i + 1, i + 1 < 10 ? &sll[i + 1] : nullptr};
+
+	long sq = dsa::from_list(&sll[0])
+		.filter([](int x) { return x % 2 == 0; })
+		.map([](int x) { return long(x) * x; })
+		.reduce(0L, std::plus<>());
+	CHECK(sq == 4 + 16 + 36 + 64 + 100);
+
+	std::vector<int> out;
+	dsa::from_list(&sll[0]).map([](int x) { return x * 10; }).take(3).collect(std::back_inserter(out));
+	CHECK((out == std::vector<int>{10, 20, 30}));
+
+	// take() stops the walk: nothing after the third item is visited.
+	int visited = 0;
+	dsa::from_list(&sll[0]).map([&](int x) { visited++; return x; }).take(3).for_each([](int) {});
+	CHECK(visited == 3);
+
+	CHECK(dsa::from_list(&sll[0]).filter([](int x) { return x > 7; }).count() == 3);
+	CHECK(dsa::from_list<dsa::sll_node<int>>(nullptr).count() == 0);
+	CHECK(dsa::from_list(&sll[0]).take(0).count() == 0);
+
+	// Stages apply in the order written: filter sees mapped values.
+	CHECK(dsa::from_list(&sll[0]).map([](int x) { return x + 100; }).filter([](int x) { return x > 105; }).count() == 5);
+
+	// Pipelines are values: a base can be extended twice.
+	auto evens = dsa::from_list(&sll[0]).filter([](int x) { return x % 2 == 0; });
+	CHECK(evens.count() == 5);
+	CHECK(evens.take(2).count() == 2);
+
+	// A 5-node CDLL ring, started mid-ring: every node exactly once.
+	std::vector<dsa::dll_node<int>> ring(5);
+	for (int i = 0; i < 5; i++)
+		ring[i] = {i, &ring[(i + 4) % 5], &ring[(i + 1) % 5]};
+	out.clear();
+	dsa::from_ring(&ring[3]).collect(std::back_inserter(out));
+	CHECK((out == std::vector<int>{3, 4, 0, 1, 2}));
+	CHECK(dsa::from_ring(&ring[0]).reduce(0, std::plus<>()) == 10);
+
+	// A single-node ring.
+	dsa::dll_node<int> one{7, nullptr, nullptr};
+	one.prev = one.next = &one;
+	CHECK(dsa::from_ring(&one).count() == 1);
+
+	return dsa_test::check_result("list_pipeline");
+}
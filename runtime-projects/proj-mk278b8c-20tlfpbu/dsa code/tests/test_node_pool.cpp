@@ -0,0 +1,126 @@
+// Node pool chunk accounting: refills, the high/low-water trim counts,
+// reuse of empty and trimmed chunks before mapping new ones, request_trim,
+// adopt(), oversize requests, and use as an engine list's resource.
+#include <cstring>
+#include <vector>
+#include "check.hpp"
+#include "list_engine.hpp"
+#include "node_pool.hpp"
+
+int main()
+{
+	dsa::pool_trim_policy policy;
+	policy.high_empty = 8;
+	policy.low_empty = 2;
+	dsa::node_pool pool(24, alignof(std::max_align_t), policy);
+	const std::size_t size = pool.node_size();
+	CHECK(size >= 24 && size % alignof(std::max_align_t) == 0);
+
+	// Nodes per chunk, learned from when the second chunk is mapped.
+	std::vector<void *> nodes;
+	while (pool.stats().chunks < 2)
+		nodes.push_back(pool.allocate(24, 8));
+	const std::size_t per_chunk = nodes.size() - 1;
+	CHECK(per_chunk > 1000 && per_chunk * size <= dsa::node_pool::chunk_size);
+
+	// Fill 20 chunks exactly; every node is distinct and writable.
+	while (nodes.size() < 20 * per_chunk)
+		nodes.push_back(pool.allocate(24, 8));
+	for (void * p : nodes)
+		std::memset(p, 0xAB, 24);
+	CHECK(pool.stats().chunks == 20 && pool.stats().refills == 20);
+	CHECK(pool.stats().live_nodes == nodes.size() && pool.stats().empty_chunks == 0);
+	CHECK(pool.resident_bytes() == 20 * dsa::node_pool::chunk_size);
+
+	// Freeing in allocation order empties chunks one by one. Empty count
+	// runs 1..9, trims to 2, runs 3..9, trims to 2, then ends at 6.
+	for (void * p : nodes)
+		pool.deallocate(p, 24, 8);
+	CHECK(pool.stats().live_nodes == 0);
+	CHECK(pool.stats().trims == 2);
+	CHECK(pool.stats().trimmed_chunks == 14);
+	CHECK(pool.stats().empty_chunks == 6);
+	CHECK(pool.stats().chunks == 20);
+	CHECK(pool.resident_bytes() == 6 * dsa::node_pool::chunk_size);
+
+	// Refilling takes empty chunks, then trimmed ones, before mapping more.
+	nodes.clear();
+	for (std::size_t i = 0; i < 20 * per_chunk; i++)
+		nodes.push_back(pool.allocate(24, 8));
+	CHECK(pool.stats().chunks == 20 && pool.stats().refills == 20);
+	CHECK(pool.stats().empty_chunks == 0 && pool.stats().trimmed_chunks == 0);
+	for (void * p : nodes)
+		std::memset(p, 0xCD, 24); // trimmed pages fault back in
+	for (void * p : nodes)
+		pool.deallocate(p, 24, 8);
+
+	// request_trim() is honoured on the next operation.
+	CHECK(pool.stats().empty_chunks > 0);
+	pool.request_trim();
+	void * one = pool.allocate(24, 8);
+	CHECK(pool.stats().empty_chunks == 0);
+	pool.deallocate(one, 24, 8);
+	pool.trim(0);
+	CHECK(pool.stats().empty_chunks == 0 && pool.resident_bytes() == 0);
+
+	// Oversize or overaligned requests go upstream.
+	void * big = pool.allocate(size + 1, 8);
+	CHECK(pool.stats().oversize == 1 && pool.stats().live_nodes == 0);
+	pool.deallocate(big, size + 1, 8);
+
+	// Nodes too big (or too aligned) for a chunk never carve one.
+	{
+		dsa::node_pool huge(dsa::node_pool::chunk_size), wide(64, 2 * dsa::node_pool::chunk_size);
+		void * h = huge.allocate(dsa::node_pool::chunk_size, 8);
+		void * w = wide.allocate(64, 64);
+		CHECK(huge.stats().chunks == 0 && huge.stats().oversize == 1);
+		CHECK(wide.stats().chunks == 0 && wide.stats().oversize == 1);
+		std::memset(h, 1, dsa::node_pool::chunk_size);
+		huge.deallocate(h, dsa::node_pool::chunk_size, 8);
+		wide.deallocate(w, 64, 64);
+	}
+
+	// adopt(): nodes of another pool are freed through this one.
+	{
+		dsa::node_pool a(24), b(24), odd(40);
+		std::vector<void *> from_b;
+		b.deallocate(b.allocate(24, 8), 24, 8);
+		b.trim(0);
+		for (int i = 0; i < 5000; i++)
+			from_b.push_back(b.allocate(24, 8));
+		void * from_a = a.allocate(24, 8);
+		void * big_b = b.allocate(64, 8);
+		const std::size_t b_chunks = b.stats().chunks;
+		std::pmr::monotonic_buffer_resource other_up;
+		dsa::node_pool c(24, alignof(std::max_align_t), dsa::pool_trim_policy(), &other_up);
+		CHECK(!a.adopt(odd) && !a.adopt(a) && !a.adopt(c));
+		CHECK(a.adopt(b));
+		CHECK(b.stats().chunks == 0 && b.stats().live_nodes == 0);
+		CHECK(b.stats().trims == 0 && b.stats().oversize == 0);
+		CHECK(a.stats().chunks == b_chunks + 1 && a.stats().live_nodes == 5001);
+		CHECK(a.stats().trims == 1 && a.stats().oversize == 1);
+		a.deallocate(big_b, 64, 8);
+		for (void * p : from_b)
+			a.deallocate(p, 24, 8);
+		a.deallocate(from_a, 24, 8);
+		CHECK(a.stats().live_nodes == 0);
+		void * again = b.allocate(24, 8); // b still works, with fresh chunks
+		b.deallocate(again, 24, 8);
+	}
+
+	// As a list's resource.
+	{
+		dsa::node_pool np(sizeof(dsa::sll_node<int>), alignof(dsa::sll_node<int>));
+		dsa::sll<int> l(&np);
+		for (int i = 0; i < 10000; i++)
+			l.insert_end(i);
+		CHECK(np.stats().live_nodes == 10000);
+		for (int i = 0; i < 10000; i += 2)
+			l.delete_beg();
+		CHECK(np.stats().live_nodes == 5000);
+		l.clear();
+		CHECK(np.stats().live_nodes == 0);
+	}
+
+	return dsa_test::check_result("node_pool");
+}
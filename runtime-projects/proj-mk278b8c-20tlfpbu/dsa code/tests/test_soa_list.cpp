@@ -0,0 +1,145 @@
+// soa_list against a std::deque of records: search positions, count_if,
+// cold fields staying with their keys across block splits at both ends,
+// and every block returned on clear.
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "check.hpp"
+#include "list_payload.hpp"
+#include "soa_list.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 5;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+	long live = 0;
+
+private:
+	void * do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		live++;
+		return std::pmr::new_delete_resource()->allocate(bytes, align);
+	}
+	void do_deallocate(void * p, std::size_t bytes, std::size_t align) override
+	{
+		live--;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+	}
+	bool do_is_equal(const std::pmr::memory_resource & o) const noexcept override { return this == &o; }
+};
+
+// Cold fields are derived from the key, so any row can be checked alone.
+double weight(int k) { return k * 0.5; }
+dsa::inline_string<24> name(int k) { return std::string_view("k" + std::to_string(k)); }
+
+} // namespace
+
+int main()
+{
+	using st = dsa::list_status;
+	counting_resource mr;
+	{
+		dsa::soa_list<8, int, double, dsa::inline_string<24>> l(&mr);
+		std::deque<int> m;
+		CHECK(l.delete_beg() == st::underflow && l.delete_end() == st::underflow);
+		CHECK(l.search(1) == 0);
+
+		for (int step = 0; step < 20000; step++)
+		{
+			int k = int(rnd() % 200);
+			switch (rnd() % 6)
+			{
+			case 0:
+			case 1:
+				CHECK(l.insert_beg(k, weight(k), name(k)) == st::ok);
+				m.push_front(k);
+				break;
+			case 2:
+			case 3:
+				CHECK(l.insert_end(k, weight(k), name(k)) == st::ok);
+				m.push_back(k);
+				break;
+			case 4:
+				CHECK(l.delete_beg() == (m.empty() ? st::underflow : st::ok));
+				if (!m.empty())
+					m.pop_front();
+				break;
+			default:
+				CHECK(l.delete_end() == (m.empty() ? st::underflow : st::ok));
+				if (!m.empty())
+					m.pop_back();
+				break;
+			}
+			CHECK(l.length() == m.size() && l.empty() == m.empty());
+
+			if (step % 97 == 0)
+			{
+				auto at = std::find(m.begin(), m.end(), k);
+				CHECK(l.search(k) == (at == m.end() ? 0 : std::size_t(at - m.begin()) + 1));
+				auto small = [](int x) { return x < 50; };
+				CHECK(l.count_if(small) == std::size_t(std::count_if(m.begin(), m.end(), small)));
+
+				std::size_t i = 0;
+				bool rows_ok = true;
+				l.for_each([&](auto row) {
+					int key = row.template get<0>();
+					rows_ok = rows_ok && i < m.size() && key == m[i] && row.template get<1>() == weight(key) &&
+						row.template get<2>() == name(key);
+					i++;
+				});
+				CHECK(rows_ok && i == m.size());
+
+				std::size_t matched = 0;
+				l.for_each_match(small, [&](auto row) {
+					int key = row.template get<0>();
+					CHECK(key < 50 && row.template get<2>() == name(key));
+					matched++;
+				});
+				CHECK(matched == l.count_if(small));
+
+				std::size_t seen = 0;
+				l.for_each_key_block([&](const int * keys, std::size_t n) {
+					CHECK(n >= 1 && n <= 8);
+					for (std::size_t j = 0; j < n; j++)
+						CHECK(keys[j] == m[seen + j]);
+					seen += n;
+				});
+				CHECK(seen == m.size());
+			}
+		}
+		// Never more blocks than the ends can leave partly filled.
+		CHECK(std::size_t(mr.live) <= (m.size() + 7) / 8 + 2);
+
+		// Rows of a const list are read-only; rows of a mutable one write through.
+		const auto & cl = l;
+		cl.for_each([](auto row) {
+			static_assert(std::is_same_v<decltype(row.template get<0>()), const int &>);
+			static_assert(std::is_same_v<decltype(row.template get<1>()), const double &>);
+		});
+		if (!m.empty())
+		{
+			auto first = [&](int k) { return k == m.front(); };
+			l.for_each_match(first, [](auto row) { row.template get<1>() = -1.0; });
+			cl.for_each_match(first, [](auto row) { CHECK(row.template get<1>() == -1.0); });
+		}
+
+		l.clear();
+		CHECK(l.empty() && mr.live == 0);
+		CHECK(l.insert_end(3, weight(3), name(3)) == st::ok && l.search(3) == 1);
+	}
+	CHECK(mr.live == 0);
+
+	return dsa_test::check_result("soa_list");
+}
@@ -0,0 +1,153 @@
+// Every fixed-capacity shape driven by the same seeded op stream as a
+// std::deque model: contents, lengths, overflow at capacity, underflow when
+// empty, and slot reuse after deletes.
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+#include "static_list.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 12345;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+template <class L>
+std::vector<int> contents(const L & l)
+{
+	std::vector<int> v;
+	l.for_each([&](int x) { v.push_back(x); });
+	return v;
+}
+
+constexpr std::size_t cap = 37;
+using st = dsa::list_status;
+
+// Lists with insert_beg/insert_end/delete_beg/delete_end.
+template <class L>
+void check_ends()
+{
+	L l;
+	std::deque<int> m;
+	for (int step = 0; step < 20000; step++)
+	{
+		int item = int(rnd() % 1000);
+		int out = -1;
+		switch (rnd() % 4)
+		{
+		case 0:
+			CHECK(l.insert_beg(item) == (m.size() < cap ? st::ok : st::overflow));
+			if (m.size() < cap)
+				m.push_front(item);
+			break;
+		case 1:
+			CHECK(l.insert_end(item) == (m.size() < cap ? st::ok : st::overflow));
+			if (m.size() < cap)
+				m.push_back(item);
+			break;
+		case 2:
+			CHECK(l.delete_beg(&out) == (m.empty() ? st::underflow : st::ok));
+			if (!m.empty())
+			{
+				CHECK(out == m.front());
+				m.pop_front();
+			}
+			break;
+		case 3:
+			CHECK(l.delete_end(&out) == (m.empty() ? st::underflow : st::ok));
+			if (!m.empty())
+			{
+				CHECK(out == m.back());
+				m.pop_back();
+			}
+			break;
+		}
+		CHECK(l.length() == m.size());
+		if (step % 97 == 0)
+		{
+			CHECK(contents(l) == std::vector<int>(m.begin(), m.end()));
+			if constexpr (!std::is_same_v<L, dsa::static_csll<int, cap>>) // csll has no search
+			{
+				auto it = std::find(m.begin(), m.end(), item);
+				CHECK(l.search(item) == (it == m.end() ? 0 : std::size_t(it - m.begin()) + 1));
+			}
+		}
+	}
+	l.clear();
+	CHECK(l.empty() && contents(l).empty());
+	for (std::size_t i = 0; i < cap; i++)
+		CHECK(l.insert_end(int(i)) == st::ok);
+	CHECK(l.insert_beg(-1) == st::overflow);
+}
+
+} // namespace
+
+int main()
+{
+	check_ends<dsa::static_sll<int, cap>>();
+	check_ends<dsa::static_dll<int, cap>>();
+	check_ends<dsa::static_csll<int, cap>>();
+
+	// DLL: insert_loc positions and the reverse walk.
+	dsa::static_dll<int, 8> d;
+	CHECK(d.insert_loc(1, 2) == st::not_found);
+	CHECK(d.insert_loc(1, 1) == st::ok);
+	CHECK(d.insert_loc(3, 2) == st::ok);
+	CHECK(d.insert_loc(2, 2) == st::ok);
+	CHECK(d.insert_loc(0, 1) == st::ok);
+	CHECK(d.insert_loc(4, 5) == st::ok);
+	CHECK(d.insert_loc(9, 0) == st::not_found);
+	CHECK((contents(d) == std::vector<int>{0, 1, 2, 3, 4}));
+	std::vector<int> rev;
+	d.for_each_reverse([&](int x) { rev.push_back(x); });
+	CHECK((rev == std::vector<int>{4, 3, 2, 1, 0}));
+
+	// CSLL: rotate moves the old head to the end.
+	dsa::static_csll<int, 8> c;
+	c.rotate(); // no-op when empty
+	for (int i = 0; i < 4; i++)
+		c.insert_end(i);
+	c.rotate();
+	CHECK((contents(c) == std::vector<int>{1, 2, 3, 0}));
+
+	// Stack: LIFO, peek, top-to-bottom walk, overflow.
+	dsa::static_stack<int, 4> s;
+	int out = 0;
+	CHECK(s.pop(&out) == st::underflow && s.peek() == nullptr);
+	for (int i = 0; i < 4; i++)
+		CHECK(s.push(i) == st::ok);
+	CHECK(s.push(9) == st::overflow);
+	CHECK(*s.peek() == 3);
+	CHECK((contents(s) == std::vector<int>{3, 2, 1, 0}));
+	CHECK(s.pop(&out) == st::ok && out == 3 && s.length() == 3);
+
+	// Queue: FIFO across the ring's wrap point.
+	dsa::static_queue<int, 4> q;
+	CHECK(q.dequeue(&out) == st::underflow);
+	std::deque<int> qm;
+	for (int i = 0; i < 50; i++)
+	{
+		if (qm.size() < 4 && i % 3 != 2)
+		{
+			CHECK(q.enqueue(i) == st::ok);
+			qm.push_back(i);
+		}
+		else if (!qm.empty())
+		{
+			CHECK(q.dequeue(&out) == st::ok && out == qm.front());
+			qm.pop_front();
+		}
+		CHECK(contents(q) == std::vector<int>(qm.begin(), qm.end()));
+	}
+	while (q.length() < 4)
+		q.enqueue(0);
+	CHECK(q.enqueue(1) == st::overflow);
+
+	return dsa_test::check_result("static_list");
+}
@@ -0,0 +1,114 @@
+// Unrolled list against a std::deque model for several payload widths
+// (plain char included) and block sizes: contents, search positions,
+// sums, and no empty blocks left behind.
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "check.hpp"
+#include "unrolled_list.hpp"
+
+namespace {
+
+std::uint32_t rng_state = 99;
+std::uint32_t rnd()
+{
+	rng_state = rng_state * 1664525u + 1013904223u;
+	return rng_state >> 8;
+}
+
+template <class T, std::size_t B>
+void check_model()
+{
+	using st = dsa::list_status;
+	dsa::unrolled_list<T, B> l;
+	std::deque<T> m;
+	for (int step = 0; step < 6000; step++)
+	{
+		T item = T(rnd() % 100);
+		T out{};
+		// Inserts outweigh deletes early on, then the list drains.
+		unsigned op = rnd() % 8;
+		if (step > 4000)
+			op = 4 + op % 4;
+		if (op < 2)
+		{
+			CHECK(l.insert_beg(item) == st::ok);
+			m.push_front(item);
+		}
+		else if (op < 4)
+		{
+			CHECK(l.insert_end(item) == st::ok);
+			m.push_back(item);
+		}
+		else if (op < 6)
+		{
+			CHECK(l.delete_beg(&out) == (m.empty() ? st::underflow : st::ok));
+			if (!m.empty())
+			{
+				CHECK(out == m.front());
+				m.pop_front();
+			}
+		}
+		else
+		{
+			CHECK(l.delete_end(&out) == (m.empty() ? st::underflow : st::ok));
+			if (!m.empty())
+			{
+				CHECK(out == m.back());
+				m.pop_back();
+			}
+		}
+		CHECK(l.length() == m.size());
+		if (step % 53 == 0)
+		{
+			std::vector<T> got;
+			l.for_each([&](T x) { got.push_back(x); });
+			CHECK(got == std::vector<T>(m.begin(), m.end()));
+
+			std::size_t want = 0;
+			for (std::size_t i = 0; i < m.size() && want == 0; i++)
+				if (m[i] == item)
+					want = i + 1;
+			CHECK(l.search(item) == want);
+
+			std::int64_t sum = 0;
+			for (T x : m)
+				sum += std::int64_t(x);
+			CHECK(std::int64_t(l.sum()) == sum);
+
+			// Every block holds at least one item.
+			std::size_t blocks = 0;
+			l.for_each_block([&](const T *, std::size_t n) {
+				CHECK(n > 0 && n <= B);
+				blocks++;
+			});
+			CHECK(blocks == l.blocks());
+		}
+	}
+	CHECK(l.empty() == m.empty());
+	l.clear();
+	CHECK(l.empty() && l.blocks() == 0);
+}
+
+} // namespace
+
+int main()
+{
+	check_model<char, 16>();
+	check_model<signed char, 64>();
+	check_model<std::int8_t, dsa::default_block_items<std::int8_t>>();
+	check_model<short, 8>();
+	check_model<int, 2>();
+	check_model<int, 64>();
+	check_model<long long, 5>();
+	check_model<double, 7>();
+
+	// Appending n items fills blocks densely.
+	dsa::unrolled_list<int, 32> l;
+	for (int i = 0; i < 1000; i++)
+		l.insert_end(i);
+	CHECK(l.blocks() == (1000 + 31) / 32);
+	CHECK(l.search(999) == 1000 && l.search(1000) == 0);
+
+	return dsa_test::check_result("unrolled_list");
+}
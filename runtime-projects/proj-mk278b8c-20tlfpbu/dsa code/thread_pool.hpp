@@ -0,0 +1,122 @@
+// Fixed-size worker pool used by the parallel list kernels.
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "list_probes.h"
+
+namespace dsa {
+
+class thread_pool
+{
+public:
+	explicit thread_pool(std::size_t workers = std::thread::hardware_concurrency())
+	{
+		if (workers == 0)
+			workers = 1;
+		for (std::size_t i = 0; i < workers; i++)
+			threads_.emplace_back([this] { worker(); });
+	}
+
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lk(mu_);
+			stop_ = true;
+		}
+		cv_.notify_all();
+		for (auto & t : threads_)
+			t.join();
+	}
+
+	thread_pool(const thread_pool &) = delete;
+	thread_pool & operator=(const thread_pool &) = delete;
+
+	std::size_t size() const { return threads_.size(); }
+
+	// Runs fn(0) .. fn(n-1) on the pool and blocks until all have finished.
+	// The caller thread takes part, so nested or single-core use never stalls.
+	template <class F>
+	void run_n(std::size_t n, F && fn)
+	{
+		if (n == 0)
+			return;
+		std::mutex done_mu;
+		std::condition_variable done_cv;
+		std::size_t pending = n - 1;
+		{
+			std::unique_lock<std::mutex> lk = lock_queue();
+			for (std::size_t i = 1; i < n; i++)
+				jobs_.emplace_back([&, i] {
+					fn(i);
+					std::lock_guard<std::mutex> dl(done_mu);
+					if (--pending == 0)
+						done_cv.notify_one();
+				});
+		}
+		cv_.notify_all();
+		fn(0);
+		// Help drain the queue instead of idling while workers catch up.
+		while (run_one())
+			;
+		std::unique_lock<std::mutex> dl(done_mu);
+		done_cv.wait(dl, [&] { return pending == 0; });
+	}
+
+private:
+	// Takes the queue lock; the queue_contended probe marks each time it
+	// was already held.
+	std::unique_lock<std::mutex> lock_queue()
+	{
+		std::unique_lock<std::mutex> lk(mu_, std::try_to_lock);
+		if (!lk.owns_lock())
+		{
+			LIST_PROBE1(queue_contended, this);
+			lk.lock();
+		}
+		return lk;
+	}
+
+	bool run_one()
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lk = lock_queue();
+			if (jobs_.empty())
+				return false;
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		job();
+		return true;
+	}
+
+	void worker()
+	{
+		for (;;)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lk(mu_);
+				cv_.wait(lk, [this] { return stop_ || !jobs_.empty(); });
+				if (stop_ && jobs_.empty())
+					return;
+				job = std::move(jobs_.front());
+				jobs_.pop_front();
+			}
+			job();
+		}
+	}
+
+	std::vector<std::thread> threads_;
+	std::deque<std::function<void()>> jobs_;
+	std::mutex mu_;
+	std::condition_variable cv_;
+	bool stop_ = false;
+};
+
+} // namespace dsa
@@ -0,0 +1,203 @@
+// Unrolled list: a doubly linked list of fixed-size blocks, each holding up
+// to B payloads contiguously. Ends are O(1) and scans run over arrays, so
+// a search touches n/B links instead of n.
+//
+// Blocks are packed at the payload's own width, so unrolled_list<int8_t>
+// stores a byte per item where an sll<int> node costs sixteen. The default
+// B keeps narrow blocks at 256 bytes of payload, and search()/sum() run the
+// per-width kernels of list_kernels.hpp over each block.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include "list_kernels.hpp"
+#include "list_traits.hpp"
+
+namespace dsa {
+
+template <class T>
+constexpr std::size_t default_block_items = 256 / sizeof(T) > 64 ? 256 / sizeof(T) : 64;
+
+template <class T, std::size_t B = default_block_items<T>>
+class unrolled_list
+{
+	static_assert(B >= 2, "blocks must hold at least two items");
+
+public:
+	using value_type = T;
+	static constexpr std::size_t block_capacity = B;
+
+	// Live items are items[begin, begin + count).
+	struct block
+	{
+		block * prev;
+		block * next;
+		std::uint32_t begin;
+		std::uint32_t count;
+		T items[B];
+	};
+
+	explicit unrolled_list(std::pmr::memory_resource * mr = std::pmr::get_default_resource()) : mr_(mr) {}
+	~unrolled_list() { clear(); }
+
+	unrolled_list(unrolled_list && o) noexcept : mr_(o.mr_), head_(o.head_), tail_(o.tail_), len_(o.len_), blocks_(o.blocks_)
+	{
+		o.head_ = o.tail_ = nullptr;
+		o.len_ = o.blocks_ = 0;
+	}
+	unrolled_list(const unrolled_list &) = delete;
+	unrolled_list & operator=(const unrolled_list &) = delete;
+
+	std::size_t length() const { return len_; }
+	bool empty() const { return len_ == 0; }
+	std::size_t blocks() const { return blocks_; }
+	block * first_block() const { return head_; }
+
+	list_status insert_beg(T item)
+	{
+		if (head_ == nullptr || head_->begin == 0)
+		{
+			// New blocks for the front fill from the right.
+			block * b = make_block(B);
+			if (b == nullptr)
+				return list_status::overflow;
+			link_before(head_, b);
+		}
+		head_->items[--head_->begin] = std::move(item);
+		head_->count++;
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status insert_end(T item)
+	{
+		if (tail_ == nullptr || tail_->begin + tail_->count == B)
+		{
+			block * b = make_block(0);
+			if (b == nullptr)
+				return list_status::overflow;
+			link_before(nullptr, b);
+		}
+		tail_->items[tail_->begin + tail_->count++] = std::move(item);
+		len_++;
+		return list_status::ok;
+	}
+
+	list_status delete_beg(T * out = nullptr)
+	{
+		if (head_ == nullptr)
+			return list_status::underflow;
+		if (out)
+			*out = std::move(head_->items[head_->begin]);
+		head_->begin++;
+		if (--head_->count == 0)
+			unlink(head_);
+		len_--;
+		return list_status::ok;
+	}
+
+	list_status delete_end(T * out = nullptr)
+	{
+		if (tail_ == nullptr)
+			return list_status::underflow;
+		--tail_->count;
+		if (out)
+			*out = std::move(tail_->items[tail_->begin + tail_->count]);
+		if (tail_->count == 0)
+			unlink(tail_);
+		len_--;
+		return list_status::ok;
+	}
+
+	// 1-based position like searching_sll, or 0 when absent.
+	std::size_t search(const T & item) const
+	{
+		std::size_t base = 0;
+		for (block * b = head_; b != nullptr; b = b->next)
+		{
+			std::size_t i = find_first(static_cast<const T *>(b->items + b->begin), b->count, item);
+			if (i < b->count)
+				return base + i + 1;
+			base += b->count;
+		}
+		return 0;
+	}
+
+	sum_type<T> sum() const
+	{
+		sum_type<T> s = 0;
+		for (block * b = head_; b != nullptr; b = b->next)
+			s += dsa::sum(static_cast<const T *>(b->items + b->begin), b->count);
+		return s;
+	}
+
+	template <class F>
+	void for_each(F && f) const
+	{
+		for (block * b = head_; b != nullptr; b = b->next)
+			for (std::uint32_t i = 0; i < b->count; i++)
+				f(b->items[b->begin + i]);
+	}
+
+	// f(const T * items, std::size_t count) once per block, for array kernels.
+	template <class F>
+	void for_each_block(F && f) const
+	{
+		for (block * b = head_; b != nullptr; b = b->next)
+			f(static_cast<const T *>(b->items + b->begin), std::size_t(b->count));
+	}
+
+	void clear()
+	{
+		while (head_ != nullptr)
+			unlink(head_);
+		len_ = 0;
+	}
+
+private:
+	block * make_block(std::uint32_t begin)
+	{
+		void * p;
+		try
+		{
+			p = mr_->allocate(sizeof(block), alignof(block));
+		}
+		catch (const std::bad_alloc &)
+		{
+			return nullptr;
+		}
+		block * b = ::new (p) block;
+		b->begin = begin;
+		b->count = 0;
+		blocks_++;
+		return b;
+	}
+
+	// Links b before `at`, or at the tail when `at` is null.
+	void link_before(block * at, block * b)
+	{
+		b->next = at;
+		b->prev = at ? at->prev : tail_;
+		(b->prev ? b->prev->next : head_) = b;
+		(at ? at->prev : tail_) = b;
+	}
+
+	void unlink(block * b)
+	{
+		(b->prev ? b->prev->next : head_) = b->next;
+		(b->next ? b->next->prev : tail_) = b->prev;
+		b->~block();
+		mr_->deallocate(b, sizeof(block), alignof(block));
+		blocks_--;
+	}
+
+	std::pmr::memory_resource * mr_;
+	block * head_ = nullptr;
+	block * tail_ = nullptr;
+	std::size_t len_ = 0;
+	std::size_t blocks_ = 0;
+};
+
+} // namespace dsa